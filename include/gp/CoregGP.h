@@ -0,0 +1,171 @@
+/**
+ * @file gp/CoregGP.h
+ * Defines the bayes::gp::CoregGP class.
+ * This provides a multiple output Gaussian Process, with a coregionalised
+ * covariance function.
+ */
+#ifndef BAYES_GP_COREGGP_H
+#define BAYES_GP_COREGGP_H
+
+#include<cmath>
+#include<stdexcept>
+#include<vector>
+#include<Eigen/Dense>
+#include<gp/CovCoreg.h>
+#include<gp/KronSolver.h>
+
+/**
+ * Namespace for all public functions and types in the bayes-cpp library.
+ */
+namespace bayes {
+
+/**
+ * Namespace for functions and types used for Gaussian Process inference.
+ */
+namespace gp {
+
+/**
+ * A zero mean, multiple output Gaussian Process with an intrinsic
+ * coregionalisation covariance function \f$B\otimes K\f$, and independent
+ * observation noise with the same variance \f$\sigma^2\f$ for every output.
+ * Inference uses bayes::gp::KronSolver, so fitting \f$p\f$ outputs to
+ * \f$n\f$ points costs \f$O(n^3+p^3)\f$ rather than \f$O(n^3p^3)\f$.
+ * @tparam Cov the type of the input covariance function. This should not
+ * include a noise term, which is instead specified separately.
+ */
+template<class Cov> class CoregGP
+{
+private:
+
+   /**
+    * The covariance function.
+    */
+   CovCoreg<Cov> cov_i;
+
+   /**
+    * The observation noise variance.
+    */
+   double noise_i;
+
+   /**
+    * The training inputs, one point per column.
+    */
+   Eigen::MatrixXd inputs_i;
+
+   /**
+    * Solver for the training covariance.
+    */
+   KronSolver solver_i;
+
+   /**
+    * Training covariance inverse times training outputs, with one column
+    * per output.
+    */
+   Eigen::MatrixXd alpha_i;
+
+   /**
+    * Log marginal likelihood of the training outputs.
+    */
+   double logLikelihood_i;
+
+public:
+
+   /**
+    * Constructs a Gaussian Process that has not yet been fitted to data.
+    * @param[in] cov the coregionalised covariance function.
+    * @param[in] noise the observation noise variance.
+    */
+   CoregGP(const CovCoreg<Cov>& cov, double noise)
+      : cov_i(cov), noise_i(noise), logLikelihood_i(0) {}
+
+   /**
+    * Returns a reference to the covariance function.
+    * Changing the covariance function does not refit the model.
+    */
+   CovCoreg<Cov>& cov() { return cov_i; }
+
+   /**
+    * Returns a reference to the covariance function.
+    */
+   const CovCoreg<Cov>& cov() const { return cov_i; }
+
+   /**
+    * Returns the training inputs, one point per column.
+    */
+   const Eigen::MatrixXd& inputs() const { return inputs_i; }
+
+   /**
+    * Returns the training covariance inverse times the training outputs,
+    * with one column per output.
+    */
+   const Eigen::MatrixXd& alpha() const { return alpha_i; }
+
+   /**
+    * Returns the log marginal likelihood of the training outputs.
+    */
+   double logLikelihood() const { return logLikelihood_i; }
+
+   /**
+    * Conditions this Gaussian Process on a set of training data.
+    * @param[in] x the training inputs, one point per column.
+    * @param[in] y the training outputs, with one row per column of \c x,
+    * and one column per output.
+    * @throws std::runtime_error if the training covariance is not
+    * positive definite.
+    */
+   template<class MX, class MY> void fit(const MX& x, const MY& y)
+   {
+      if( (x.cols()!=y.rows()) || (cov_i.outputs()!=y.cols()) )
+      {
+         throw std::invalid_argument("CoregGP: inputs and outputs differ "
+                                     "in size.");
+      }
+
+      //************************************************************************
+      // Decompose the Kronecker factors of the training covariance.
+      //************************************************************************
+      inputs_i = x;
+      Eigen::ArrayXXd inputCov;
+      cov_i.cov()(inputs_i,inputCov);
+      std::vector<Eigen::MatrixXd> factors(2);
+      factors[0] = cov_i.coreg();
+      factors[1] = inputCov.matrix();
+      solver_i.compute(factors,noise_i);
+
+      //************************************************************************
+      // Solve for alpha. Stacking the columns of y matches the ordering of
+      // the Kronecker product B (x) K.
+      //************************************************************************
+      Eigen::MatrixXd yMat(y);
+      Eigen::VectorXd yVec = Eigen::Map<Eigen::VectorXd>(yMat.data(),
+                                                         yMat.size());
+      Eigen::VectorXd alphaVec = solver_i.solve(yVec);
+      alpha_i = Eigen::Map<Eigen::MatrixXd>(alphaVec.data(),y.rows(),y.cols());
+
+      logLikelihood_i = -0.5*( yVec.dot(alphaVec) + solver_i.logDeterminant()
+                               + yVec.size()*std::log(2*M_PI) );
+
+   } // fit
+
+   /**
+    * Calculates the predictive mean of every output at a set of test inputs.
+    * @param[in] x the test inputs, one point per column.
+    * @param[out] mean the predictive mean, with one row per column of \c x,
+    * and one column per output.
+    */
+   template<class MX, class MR> void predict(const MX& x, MR& mean)
+   {
+      //************************************************************************
+      // Since (B (x) K*) vec(alpha) = vec(K* alpha B^T), and B is symmetric.
+      //************************************************************************
+      Eigen::ArrayXXd cross;
+      cov_i.cov()(x,inputs_i,cross);
+      mean = cross.matrix()*alpha_i*cov_i.coreg();
+   }
+
+}; // class CoregGP
+
+} // namespace gp
+} // namespace bayes
+
+#endif // BAYES_GP_COREGGP_H
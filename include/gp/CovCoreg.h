@@ -0,0 +1,133 @@
+/**
+ * @file gp/CovCoreg.h
+ * Defines the bayes::gp::CovCoreg class.
+ * This provides an implementation of the intrinsic coregionalisation
+ * covariance function, for multiple correlated outputs.
+ */
+#ifndef BAYES_GP_COVCOREG_H
+#define BAYES_GP_COVCOREG_H
+
+#include<Eigen/Dense>
+
+/**
+ * Namespace for all public functions and types in the bayes-cpp library.
+ */
+namespace bayes {
+
+/**
+ * Namespace for functions and types used for Gaussian Process inference.
+ */
+namespace gp {
+
+/**
+ * Provides an implementation of the intrinsic coregionalisation covariance
+ * function, for modelling \f$p\f$ correlated outputs over shared inputs.
+ * The covariance between output \f$i\f$ at \f$x\f$ and output \f$j\f$ at
+ * \f$x'\f$ is \f$B_{ij}k(x,x')\f$, where \f$B\f$ is a \f$p\times p\f$
+ * positive semi-definite coregionalisation matrix, and \f$k\f$ is any other
+ * covariance function. The full covariance is therefore the Kronecker
+ * product \f$B\otimes K\f$, which bayes::gp::CoregGP exploits to avoid ever
+ * forming it. Since its result has \f$p\f$ times as many rows and columns
+ * as that of \f$k\f$, it cannot be summed with other covariance functions
+ * using operator+; observation noise is instead handled by
+ * bayes::gp::CoregGP.
+ * @tparam Cov the type of the input covariance function \f$k\f$.
+ */
+template<class Cov> class CovCoreg
+{
+private:
+
+   /**
+    * The input covariance function.
+    */
+   Cov cov_i;
+
+   /**
+    * The coregionalisation matrix.
+    */
+   Eigen::MatrixXd coreg_i;
+
+public:
+
+   /**
+    * Constructs a new Coregionalisation Covariance function.
+    * @param[in] cov the input covariance function.
+    * @param[in] coreg the coregionalisation matrix, which must be symmetric
+    * positive semi-definite.
+    */
+   CovCoreg(const Cov& cov, const Eigen::MatrixXd& coreg)
+      : cov_i(cov), coreg_i(coreg) {}
+
+   /**
+    * Returns reference to the input covariance function.
+    */
+   Cov& cov() { return cov_i; }
+
+   /**
+    * Returns reference to the input covariance function.
+    */
+   const Cov& cov() const { return cov_i; }
+
+   /**
+    * Sets the coregionalisation matrix.
+    */
+   void coreg(const Eigen::MatrixXd& coreg) { coreg_i = coreg; }
+
+   /**
+    * Gets the coregionalisation matrix.
+    */
+   const Eigen::MatrixXd& coreg() const { return coreg_i; }
+
+   /**
+    * Returns the number of outputs.
+    */
+   int outputs() const { return static_cast<int>(coreg_i.rows()); }
+
+   /**
+    * Returns the full covariance between every output at each point.
+    * This forms the complete Kronecker product, so is mainly useful for
+    * small problems and testing.
+    * @param[in] m1 first input matrix, one point per column.
+    * @param[in] m2 second input matrix, one point per column.
+    * @param[out] result matrix of size \f$pn_1\times pn_2\f$, where rows
+    * \f$in_1\f$ to \f$(i+1)n_1-1\f$ correspond to output \f$i\f$.
+    */
+   template<class M1, class M2, class MR>
+      void operator()(const M1& m1, const M2& m2, MR& result)
+   {
+      //************************************************************************
+      // Calculate the input covariance
+      //************************************************************************
+      MR inputCov;
+      cov_i(m1,m2,inputCov);
+
+      //************************************************************************
+      // Scale it for each pair of outputs
+      //************************************************************************
+      const int rows = static_cast<int>(inputCov.rows());
+      const int cols = static_cast<int>(inputCov.cols());
+      result.resize(outputs()*rows,outputs()*cols);
+      for(int i=0; i<outputs(); ++i)
+      {
+         for(int j=0; j<outputs(); ++j)
+         {
+            result.block(i*rows,j*cols,rows,cols) = coreg_i(i,j)*inputCov;
+         }
+      }
+
+   } // operator ()
+
+   /**
+    * Returns the covariance between each pair of columns in a matrix.
+    */
+   template<class M1, class MR> void operator()(const M1& m1, MR& result)
+   {
+      return (*this)(m1,m1,result);
+   }
+
+}; // class CovCoreg
+
+} // namespace gp
+} // namespace bayes
+
+#endif // BAYES_GP_COVCOREG_H
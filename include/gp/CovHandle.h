@@ -0,0 +1,247 @@
+/**
+ * @file gp/CovHandle.h
+ * Defines the bayes::gp::CovHandle class.
+ * This provides a runtime polymorphic handle to any covariance function.
+ */
+#ifndef BAYES_GP_COVHANDLE_H
+#define BAYES_GP_COVHANDLE_H
+
+#include<memory>
+#include<boost/type_traits/is_same.hpp>
+#include<boost/utility/enable_if.hpp>
+#include<Eigen/Dense>
+#include<gp/CovSum.h>
+#include<gp/isCovariance.h>
+
+/**
+ * Namespace for all public functions and types in the bayes-cpp library.
+ */
+namespace bayes {
+
+/**
+ * Namespace for functions and types used for Gaussian Process inference.
+ */
+namespace gp {
+
+/**
+ * Runtime polymorphic handle to a stationary covariance function.
+ * This allows covariance functions to be chosen at runtime (for example,
+ * using bayes::gp::CovParser) without instantiating every combination of
+ * types at compile time.
+ *
+ * Virtual dispatch happens once per call, for a whole batch of points, and
+ * never per element: the wrapped covariance function is evaluated by its
+ * own templated code, with inputs passed as Eigen::Ref. As such, the
+ * overhead compared to using the wrapped type directly is a few virtual
+ * calls per batch. Handles can be combined with operator+, like any other
+ * covariance function, and have value semantics.
+ */
+class CovHandle
+{
+private:
+
+   /**
+    * Interface to the wrapped covariance function.
+    */
+   class Base
+   {
+   public:
+
+      /**
+       * Virtual destructor.
+       */
+      virtual ~Base() {}
+
+      /**
+       * Returns a new copy of this object.
+       */
+      virtual Base* clone() const = 0;
+
+      /**
+       * Returns the covariance between each pair of columns in two matrices.
+       */
+      virtual void eval(const Eigen::Ref<const Eigen::MatrixXd>& m1,
+                        const Eigen::Ref<const Eigen::MatrixXd>& m2,
+                        Eigen::ArrayXXd& result) = 0;
+
+      /**
+       * Returns the covariance given the precomputed squared distances.
+       * @pre result has the same size as dist.
+       */
+      virtual void fromSqDist(const Eigen::Ref<const Eigen::ArrayXXd>& dist,
+                              Eigen::Ref<Eigen::ArrayXXd> result) const = 0;
+
+   }; // class Base
+
+   /**
+    * Implementation of the Base interface for a specific covariance function.
+    */
+   template<class C> class Model : public Base
+   {
+   private:
+
+      /**
+       * The wrapped covariance function.
+       */
+      C cov_i;
+
+   public:
+
+      /**
+       * Wraps a copy of a covariance function.
+       */
+      explicit Model(const C& cov) : cov_i(cov) {}
+
+      /**
+       * Returns a new copy of this object.
+       */
+      Base* clone() const { return new Model(cov_i); }
+
+      /**
+       * Returns the covariance between each pair of columns in two matrices.
+       */
+      void eval(const Eigen::Ref<const Eigen::MatrixXd>& m1,
+                const Eigen::Ref<const Eigen::MatrixXd>& m2,
+                Eigen::ArrayXXd& result)
+      {
+         cov_i(m1,m2,result);
+      }
+
+      /**
+       * Returns the covariance given the precomputed squared distances.
+       */
+      void fromSqDist(const Eigen::Ref<const Eigen::ArrayXXd>& dist,
+                      Eigen::Ref<Eigen::ArrayXXd> result) const
+      {
+         cov_i.fromSqDist(dist,result);
+      }
+
+   }; // class Model
+
+   /**
+    * The wrapped covariance function.
+    */
+   std::unique_ptr<Base> cov_i;
+
+   /**
+    * Evaluates the wrapped covariance function directly into the result.
+    */
+   void eval(const Eigen::Ref<const Eigen::MatrixXd>& m1,
+             const Eigen::Ref<const Eigen::MatrixXd>& m2,
+             Eigen::ArrayXXd& result)
+   {
+      cov_i->eval(m1,m2,result);
+   }
+
+   /**
+    * Evaluates the wrapped covariance function, for result types other
+    * than Eigen::ArrayXXd.
+    */
+   template<class MR> void eval(const Eigen::Ref<const Eigen::MatrixXd>& m1,
+                                const Eigen::Ref<const Eigen::MatrixXd>& m2,
+                                MR& result)
+   {
+      Eigen::ArrayXXd cov;
+      cov_i->eval(m1,m2,cov);
+      result = cov;
+   }
+
+   /**
+    * Returns a writable reference to an array.
+    */
+   template<class D>
+      static Eigen::Ref<Eigen::ArrayXXd> arrayRef(Eigen::ArrayBase<D>& a)
+   {
+      return a.derived();
+   }
+
+   /**
+    * Returns a writable reference to a matrix, viewed as an array.
+    */
+   template<class D>
+      static Eigen::Ref<Eigen::ArrayXXd> arrayRef(Eigen::MatrixBase<D>& m)
+   {
+      return m.array();
+   }
+
+public:
+
+   /**
+    * Constructs a handle to a copy of the given covariance function.
+    * @param[in] cov a stationary covariance function, providing a
+    * \c fromSqDist method.
+    */
+   template<class C> CovHandle(const C& cov,
+      typename boost::enable_if_c< isCovariance<C>::value &&
+         !boost::is_same<C,CovHandle>::value >::type* = 0)
+      : cov_i(new Model<C>(cov)) {}
+
+   /**
+    * Constructs a handle to a copy of another handle's covariance function.
+    */
+   CovHandle(const CovHandle& other) : cov_i(other.cov_i->clone()) {}
+
+   /**
+    * Replaces this handle's covariance function with a copy of another's.
+    */
+   CovHandle& operator=(const CovHandle& other)
+   {
+      cov_i.reset(other.cov_i->clone());
+      return *this;
+   }
+
+   /**
+    * Takes ownership of another handle's covariance function, without
+    * copying it. The other handle may then only be assigned to or destroyed.
+    */
+   CovHandle(CovHandle&& other) = default;
+
+   /**
+    * Replaces this handle's covariance function with another's, without
+    * copying it. The other handle may then only be assigned to or destroyed.
+    */
+   CovHandle& operator=(CovHandle&& other) = default;
+
+   /**
+    * Returns the covariance between points.
+    */
+   template<class M1, class M2, class MR>
+      void operator()(const M1& m1, const M2& m2, MR& result)
+   {
+      eval(m1,m2,result);
+   }
+
+   /**
+    * Returns the covariance between each pair of columns in a matrix.
+    */
+   template<class M1, class MR> void operator()(const M1& m1, MR& result)
+   {
+      return (*this)(m1,m1,result);
+   }
+
+   /**
+    * Returns the covariance given the precomputed squared distance between
+    * each pair of points.
+    * @param[in] dist array of squared distances, as computed by
+    * bayes::gp::sqdist.
+    * @param[out] result the covariance between each pair of points, which
+    * will have the same size as \c dist.
+    */
+   template<class MD, class MR>
+      void fromSqDist(const MD& dist, MR& result) const
+   {
+      result.resize(dist.rows(),dist.cols());
+      cov_i->fromSqDist(dist.array(),arrayRef(result));
+   }
+
+}; // class CovHandle
+
+/**
+ * bayes::gp::CovHandle is a covariance function.
+ */
+template<> struct isCovariance<CovHandle> : boost::true_type {};
+
+} // namespace gp
+} // namespace bayes
+
+#endif // BAYES_GP_COVHANDLE_H
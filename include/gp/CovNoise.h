@@ -9,6 +9,8 @@
 
 #include<cmath>
 #include<gp/sqdist.h>
+#include<gp/covparallel.h>
+#include<gp/isCovariance.h>
 
 /**
  * Namespace for all public functions and types in the bayes-cpp library.
@@ -48,7 +50,7 @@ public:
    /**
     * Gets the noise variance for this covariance function.
     */
-   double var() { return var_i; }
+   double var() const { return var_i; }
 
    /**
     * Returns the covariance between points.
@@ -63,17 +65,51 @@ public:
       sqdist(m1,m2,dist);
 
       //************************************************************************
-      // Substract small scalar so that equality comparison is not over
+      // From this, calculate the covariance.
+      //************************************************************************
+      fromSqDist(dist,result);
+
+   } // operator ()
+
+   /**
+    * Returns the covariance given the precomputed squared distance between
+    * each pair of points.
+    * @param[in] dist matrix or array of squared distances, as computed by
+    * bayes::gp::sqdist.
+    * @param[out] result the covariance between each pair of points, which
+    * will have the same size as \c dist.
+    */
+   template<class MD, class MR>
+      void fromSqDist(const MD& dist, MR& result) const
+   {
+      typedef typename MR::Scalar Scalar;
+      typedef Eigen::Array<Scalar,Eigen::Dynamic,Eigen::Dynamic> Zeros;
+      result.resize(dist.rows(),dist.cols());
+
+      //************************************************************************
+      // Small scalar used so that equality comparison is not over
       // sensitive to poor precision.
       //************************************************************************
-      dist -= Eigen::NumTraits<typename MR::Scalar>::dummy_precision();
+      const Scalar precision = Eigen::NumTraits<Scalar>::dummy_precision();
 
       //************************************************************************
       // From this, the covariance is zero, unless the distance is zero.
+      // Large results are split between threads by column.
       //************************************************************************
-      result = (dist<=0).template cast<typename MR::Scalar>() * var_i;
-
-   } // operator ()
+      if(dist.size() < PARALLEL_MIN_SIZE)
+      {
+         result.array() = (dist.array()<=precision)
+            .select(var_i,Zeros::Zero(dist.rows(),dist.cols()));
+         return;
+      }
+#pragma omp parallel for
+      for(int j=0; j<static_cast<int>(dist.cols()); ++j)
+      {
+         result.col(j).array() = (dist.col(j).array()<=precision)
+            .select(var_i,Zeros::Zero(dist.rows(),1));
+      }
+
+   } // fromSqDist
 
    /**
     * Returns the covariance between each pair of columns in a matrix.
@@ -85,6 +121,11 @@ public:
 
 }; // class CovNoise
 
+/**
+ * bayes::gp::CovNoise is a covariance function.
+ */
+template<> struct isCovariance<CovNoise> : boost::true_type {};
+
 } // namespace gp
 } // namespace bayes
 
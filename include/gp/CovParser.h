@@ -0,0 +1,367 @@
+/**
+ * @file gp/CovParser.h
+ * Defines the bayes::gp::CovParser class.
+ * This constructs covariance functions at runtime from text expressions.
+ */
+#ifndef BAYES_GP_COVPARSER_H
+#define BAYES_GP_COVPARSER_H
+
+#include<cctype>
+#include<cmath>
+#include<functional>
+#include<locale>
+#include<map>
+#include<sstream>
+#include<stdexcept>
+#include<string>
+#include<vector>
+#include<gp/CovSEiso.h>
+#include<gp/CovNoise.h>
+#include<gp/CovSum.h>
+#include<gp/CovHandle.h>
+
+/**
+ * Namespace for all public functions and types in the bayes-cpp library.
+ */
+namespace bayes {
+
+/**
+ * Namespace for functions and types used for Gaussian Process inference.
+ */
+namespace gp {
+
+/**
+ * Constructs covariance functions from text expressions, such as
+ * \code
+ * CovSEiso(2.0, 0.5) + CovNoise(0.1)
+ * \endcode
+ * Expressions are sums of terms, where each term is either a parenthesised
+ * expression, or the name of a covariance function followed by a
+ * parenthesised, comma separated list of parameters. Parameters are passed
+ * to the covariance function's constructor, so may be omitted to use its
+ * default values. Further covariance functions can be registered by name
+ * using add().
+ */
+class CovParser
+{
+public:
+
+   /**
+    * Function that constructs a covariance function from its parameters.
+    * This should throw std::invalid_argument if the parameters are invalid.
+    */
+   typedef std::function<CovHandle(const std::vector<double>&)> Factory;
+
+private:
+
+   /**
+    * Factories for each covariance function, indexed by name.
+    */
+   std::map<std::string,Factory> factories_i;
+
+   /**
+    * Throws std::invalid_argument describing a syntax error.
+    */
+   [[noreturn]] static void error(const std::string& text, std::size_t pos,
+                                  const std::string& message)
+   {
+      std::ostringstream out;
+      out << "Invalid covariance expression \"" << text << "\" at position "
+         << pos << ": " << message;
+      throw std::invalid_argument(out.str());
+   }
+
+   /**
+    * Advances past any whitespace, and returns the next character,
+    * or '\\0' at the end of the text.
+    */
+   static char peek(const std::string& text, std::size_t& pos)
+   {
+      while( (pos<text.size()) &&
+             std::isspace(static_cast<unsigned char>(text[pos])) )
+      {
+         ++pos;
+      }
+      return pos<text.size() ? text[pos] : '\0';
+   }
+
+   /**
+    * Consumes the next character, which must be \c expected.
+    */
+   static void expect(const std::string& text, std::size_t& pos,
+                      char expected)
+   {
+      if(expected!=peek(text,pos))
+      {
+         error(text,pos,std::string("expected '")+expected+"'");
+      }
+      ++pos;
+   }
+
+   /**
+    * Advances past any decimal digits, and returns how many there were.
+    */
+   static std::size_t skipDigits(const std::string& text, std::size_t& pos)
+   {
+      const std::size_t start = pos;
+      while( (pos<text.size()) &&
+             std::isdigit(static_cast<unsigned char>(text[pos])) )
+      {
+         ++pos;
+      }
+      return pos-start;
+   }
+
+   /**
+    * Parses a decimal number, with optional sign, fraction and exponent.
+    * This does not depend on the current locale, and does not accept the
+    * hexadecimal, infinity or nan forms recognised by std::strtod.
+    */
+   static double parseNumber(const std::string& text, std::size_t& pos)
+   {
+      //************************************************************************
+      // Find the extent of the number.
+      //************************************************************************
+      const std::size_t start = pos;
+      if( (pos<text.size()) && ('+'==text[pos] || '-'==text[pos]) )
+      {
+         ++pos;
+      }
+      std::size_t digits = skipDigits(text,pos);
+      if( (pos<text.size()) && ('.'==text[pos]) )
+      {
+         ++pos;
+         digits += skipDigits(text,pos);
+      }
+      if(0==digits)
+      {
+         error(text,start,"expected number");
+      }
+      if( (pos<text.size()) && ('e'==text[pos] || 'E'==text[pos]) )
+      {
+         ++pos;
+         if( (pos<text.size()) && ('+'==text[pos] || '-'==text[pos]) )
+         {
+            ++pos;
+         }
+         if(0==skipDigits(text,pos))
+         {
+            error(text,start,"expected exponent");
+         }
+      }
+
+      //************************************************************************
+      // Convert it using the classic locale, so that the decimal point is
+      // always '.'.
+      //************************************************************************
+      std::istringstream in(text.substr(start,pos-start));
+      in.imbue(std::locale::classic());
+      double value = 0;
+      if(!(in >> value))
+      {
+         error(text,start,"number out of range");
+      }
+      return value;
+   }
+
+   /**
+    * Parses a sum of terms.
+    */
+   CovHandle parseSum(const std::string& text, std::size_t& pos) const
+   {
+      CovHandle result = parseTerm(text,pos);
+      while('+'==peek(text,pos))
+      {
+         ++pos;
+         result = result + parseTerm(text,pos);
+      }
+      return result;
+   }
+
+   /**
+    * Parses a single named covariance function, or parenthesised sum.
+    */
+   CovHandle parseTerm(const std::string& text, std::size_t& pos) const
+   {
+      //************************************************************************
+      // Parenthesised sum
+      //************************************************************************
+      if('('==peek(text,pos))
+      {
+         ++pos;
+         CovHandle result = parseSum(text,pos);
+         expect(text,pos,')');
+         return result;
+      }
+
+      //************************************************************************
+      // Name of covariance function
+      //************************************************************************
+      const std::size_t start = pos;
+      while( (pos<text.size()) &&
+             (std::isalnum(static_cast<unsigned char>(text[pos])) ||
+              '_'==text[pos]) )
+      {
+         ++pos;
+      }
+      const std::string name = text.substr(start,pos-start);
+      std::map<std::string,Factory>::const_iterator factory =
+         factories_i.find(name);
+      if(factories_i.end()==factory)
+      {
+         error(text,start,"unknown covariance function \""+name+"\"");
+      }
+
+      //************************************************************************
+      // Parameter list
+      //************************************************************************
+      std::vector<double> params;
+      expect(text,pos,'(');
+      while(')'!=peek(text,pos))
+      {
+         if(!params.empty())
+         {
+            expect(text,pos,',');
+            peek(text,pos);
+         }
+         params.push_back(parseNumber(text,pos));
+      }
+      expect(text,pos,')');
+
+      //************************************************************************
+      // Construct the covariance function, adding context to any error.
+      //************************************************************************
+      try
+      {
+         return factory->second(params);
+      }
+      catch(std::invalid_argument& e)
+      {
+         error(text,start,e.what());
+      }
+
+   } // parseTerm
+
+   /**
+    * Checks that a covariance function has no more than \c max parameters.
+    */
+   static void checkParams(const std::string& name,
+                           const std::vector<double>& params,
+                           std::size_t max)
+   {
+      if(max<params.size())
+      {
+         std::ostringstream out;
+         out << name << " takes at most " << max << " parameters";
+         throw std::invalid_argument(out.str());
+      }
+   }
+
+   /**
+    * Checks that a parameter is finite and positive, or if \c zeroAllowed
+    * is true, finite and non-negative.
+    */
+   static void checkValue(const std::string& name, double value,
+                          bool zeroAllowed)
+   {
+      if( !std::isfinite(value) || (value<0) || (!zeroAllowed && (0==value)) )
+      {
+         std::ostringstream out;
+         out << name << " must be finite and "
+            << (zeroAllowed ? "non-negative" : "positive") << ", not "
+            << value;
+         throw std::invalid_argument(out.str());
+      }
+   }
+
+   /**
+    * Constructs bayes::gp::CovSEiso from its parameters.
+    */
+   static CovHandle makeSEiso(const std::vector<double>& params)
+   {
+      checkParams("CovSEiso",params,2);
+      CovSEiso cov;
+      if(0<params.size())
+      {
+         checkValue("CovSEiso scale",params[0],false);
+         cov.scale(params[0]);
+      }
+      if(1<params.size())
+      {
+         checkValue("CovSEiso length",params[1],false);
+         cov.length(params[1]);
+      }
+      return cov;
+   }
+
+   /**
+    * Constructs bayes::gp::CovNoise from its parameters.
+    */
+   static CovHandle makeNoise(const std::vector<double>& params)
+   {
+      checkParams("CovNoise",params,1);
+      CovNoise cov;
+      if(0<params.size())
+      {
+         checkValue("CovNoise variance",params[0],true);
+         cov.var(params[0]);
+      }
+      return cov;
+   }
+
+public:
+
+   /**
+    * Constructs a parser that recognises the covariance functions provided
+    * by this library.
+    */
+   CovParser()
+   {
+      add("CovSEiso",makeSEiso);
+      add("CovNoise",makeNoise);
+   }
+
+   /**
+    * Registers a covariance function, replacing any existing function with
+    * the same name.
+    * @param[in] name the name used in expressions.
+    * @param[in] factory function constructing the covariance function from
+    * its parameters.
+    */
+   void add(const std::string& name, const Factory& factory)
+   {
+      factories_i[name] = factory;
+   }
+
+   /**
+    * Constructs a covariance function from a text expression.
+    * @param[in] text the expression.
+    * @throws std::invalid_argument if the expression is invalid.
+    */
+   CovHandle parse(const std::string& text) const
+   {
+      std::size_t pos = 0;
+      CovHandle result = parseSum(text,pos);
+      if('\0'!=peek(text,pos))
+      {
+         error(text,pos,"unexpected character");
+      }
+      return result;
+   }
+
+}; // class CovParser
+
+/**
+ * Constructs a covariance function from a text expression, using the
+ * covariance functions provided by this library.
+ * @see bayes::gp::CovParser
+ */
+inline CovHandle parseCov(const std::string& text)
+{
+   return CovParser().parse(text);
+}
+
+} // namespace gp
+} // namespace bayes
+
+#endif // BAYES_GP_COVPARSER_H
@@ -9,6 +9,8 @@
 
 #include<cmath>
 #include<gp/sqdist.h>
+#include<gp/covparallel.h>
+#include<gp/isCovariance.h>
 
 /**
  * Namespace for all public functions and types in the bayes-cpp library.
@@ -61,12 +63,23 @@ public:
    /**
     * Gets the scale of this covariance function.
     */
-   double scale() { return std::exp(logScale_i); }
+   double scale() const { return std::exp(logScale_i); }
 
    /**
     * Gets the length scale of this covariance function.
     */
-   double length() { return length_i; }
+   double length() const { return length_i; }
+
+   /**
+    * Sets the log of the scale of this covariance function.
+    */
+   void logScale(double logScale) { logScale_i = logScale; }
+
+   /**
+    * Gets the log of the scale of this covariance function, which is how
+    * it is stored internally.
+    */
+   double logScale() const { return logScale_i; }
 
    /**
     * Returns the covariance between points.
@@ -83,11 +96,46 @@ public:
       //************************************************************************
       // From this, calculate the covariance.
       //************************************************************************
-      result = logScale_i-dist.array()/length_i;
-      result = result.exp();
+      fromSqDist(dist,result);
 
    } // operator ()
 
+   /**
+    * Returns the covariance given the precomputed squared distance between
+    * each pair of points.
+    * @param[in] dist matrix or array of squared distances, as computed by
+    * bayes::gp::sqdist.
+    * @param[out] result the covariance between each pair of points, which
+    * will have the same size as \c dist.
+    */
+   template<class MD, class MR>
+      void fromSqDist(const MD& dist, MR& result) const
+   {
+      result.resize(dist.rows(),dist.cols());
+      const typename MR::Scalar invLength = 1.0/length_i;
+
+      //************************************************************************
+      // Small results are transformed in a single vectorised expression.
+      //************************************************************************
+      if(dist.size() < PARALLEL_MIN_SIZE)
+      {
+         result.array() = (logScale_i - dist.array()*invLength).exp();
+         return;
+      }
+
+      //************************************************************************
+      // Otherwise, columns are transformed independently, so are split
+      // between threads (if OpenMP is enabled).
+      //************************************************************************
+#pragma omp parallel for
+      for(int j=0; j<static_cast<int>(dist.cols()); ++j)
+      {
+         result.col(j).array() =
+            (logScale_i - dist.col(j).array()*invLength).exp();
+      }
+
+   } // fromSqDist
+
    /**
     * Returns the covariance between each pair of columns in a matrix.
     */
@@ -98,6 +146,11 @@ public:
 
 }; // class CovSEiso
 
+/**
+ * bayes::gp::CovSEiso is a covariance function.
+ */
+template<> struct isCovariance<CovSEiso> : boost::true_type {};
+
 } // namespace gp
 } // namespace bayes
 
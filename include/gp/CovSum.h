@@ -8,7 +8,9 @@
 #define BAYES_GP_COVSUM_H
 
 #include<cmath>
+#include<boost/utility/enable_if.hpp>
 #include<gp/sqdist.h>
+#include<gp/isCovariance.h>
 
 /**
  * Namespace for all public functions and types in the bayes-cpp library.
@@ -43,7 +45,7 @@ public:
    /**
     * Constructs a new Independent Noise Covariance function.
     */
-   CovSum(const C1& c1, const C2& c2)
+   CovSum(const C1& c1=C1(), const C2& c2=C2())
       : cov1_i(c1), cov2_i(c2) {}
 
    /**
@@ -54,8 +56,18 @@ public:
    /**
     * Returns reference to first covariance function.
     */
+   const C1& cov1() const { return cov1_i; }
+
+   /**
+    * Returns reference to second covariance function.
+    */
    C2& cov2() { return cov2_i; }
 
+   /**
+    * Returns reference to second covariance function.
+    */
+   const C2& cov2() const { return cov2_i; }
+
    /**
     * Returns the covariance between points.
     */
@@ -68,6 +80,20 @@ public:
       result += part1;
    } 
 
+   /**
+    * Returns the covariance given the precomputed squared distance between
+    * each pair of points. This is only valid if both component covariance
+    * functions are stationary, and so provide a \c fromSqDist method.
+    */
+   template<class MD, class MR>
+      void fromSqDist(const MD& dist, MR& result) const
+   {
+      typename MR::PlainObject part1;
+      cov1_i.fromSqDist(dist,part1);
+      cov2_i.fromSqDist(dist,result);
+      result += part1;
+   }
+
    /**
     * Returns the covariance between each pair of columns in a matrix.
     */
@@ -78,10 +104,19 @@ public:
 
 }; // class CovSum
 
+/**
+ * bayes::gp::CovSum is a covariance function.
+ */
+template<class C1, class C2>
+struct isCovariance< CovSum<C1,C2> > : boost::true_type {};
+
 /**
  * Adds two covariance functions together.
  */
-template<class C1,class C2> CovSum<C1,C2> operator+(const C1& c1, const C2& c2)
+template<class C1,class C2>
+typename boost::enable_if_c< isCovariance<C1>::value && isCovariance<C2>::value,
+                             CovSum<C1,C2> >::type
+operator+(const C1& c1, const C2& c2)
 {
    return CovSum<C1,C2>(c1,c2);
 }
@@ -0,0 +1,151 @@
+/**
+ * @file gp/FittedGP.h
+ * Defines the bayes::gp::FittedGP class.
+ * This provides a Gaussian Process conditioned on a set of training data.
+ */
+#ifndef BAYES_GP_FITTEDGP_H
+#define BAYES_GP_FITTEDGP_H
+
+#include<stdexcept>
+#include<Eigen/Dense>
+
+/**
+ * Namespace for all public functions and types in the bayes-cpp library.
+ */
+namespace bayes {
+
+/**
+ * Namespace for functions and types used for Gaussian Process inference.
+ */
+namespace gp {
+
+/**
+ * A zero mean Gaussian Process conditioned on a set of training data.
+ * Fitting calculates the Cholesky factor \f$L\f$ of the training covariance
+ * \f$K=LL^T\f$, and \f$\alpha=K^{-1}y\f$, from which the predictive mean
+ * at new inputs can be calculated. Observation noise should be included in
+ * the covariance function, for example by adding a bayes::gp::CovNoise term.
+ * @tparam Cov the type of covariance function.
+ */
+template<class Cov> class FittedGP
+{
+private:
+
+   /**
+    * The covariance function.
+    */
+   Cov cov_i;
+
+   /**
+    * The training inputs, one point per column.
+    */
+   Eigen::MatrixXd inputs_i;
+
+   /**
+    * Lower triangular Cholesky factor of the training covariance.
+    */
+   Eigen::MatrixXd chol_i;
+
+   /**
+    * The training covariance inverse multiplied by the training outputs.
+    */
+   Eigen::VectorXd alpha_i;
+
+public:
+
+   /**
+    * Constructs a Gaussian Process that has not yet been fitted to data.
+    */
+   FittedGP(const Cov& cov=Cov()) : cov_i(cov) {}
+
+   /**
+    * Constructs a Gaussian Process from a previously fitted state.
+    * @param[in] cov the covariance function.
+    * @param[in] inputs the training inputs, one point per column.
+    * @param[in] chol lower triangular Cholesky factor of training covariance.
+    * @param[in] alpha training covariance inverse times training outputs.
+    */
+   FittedGP(const Cov& cov, const Eigen::MatrixXd& inputs,
+            const Eigen::MatrixXd& chol, const Eigen::VectorXd& alpha)
+      : cov_i(cov), inputs_i(inputs), chol_i(chol), alpha_i(alpha) {}
+
+   /**
+    * Returns a reference to the covariance function.
+    * Changing the covariance function does not refit the model.
+    */
+   Cov& cov() { return cov_i; }
+
+   /**
+    * Returns a reference to the covariance function.
+    */
+   const Cov& cov() const { return cov_i; }
+
+   /**
+    * Returns the training inputs, one point per column.
+    */
+   const Eigen::MatrixXd& inputs() const { return inputs_i; }
+
+   /**
+    * Returns the lower triangular Cholesky factor of the training covariance.
+    */
+   const Eigen::MatrixXd& chol() const { return chol_i; }
+
+   /**
+    * Returns the training covariance inverse times the training outputs.
+    */
+   const Eigen::VectorXd& alpha() const { return alpha_i; }
+
+   /**
+    * Conditions this Gaussian Process on a set of training data.
+    * @param[in] x the training inputs, one point per column.
+    * @param[in] y the training outputs, one per column of \c x.
+    * @throws std::runtime_error if the training covariance is not
+    * positive definite.
+    */
+   template<class MX, class VY> void fit(const MX& x, const VY& y)
+   {
+      if(x.cols()!=y.size())
+      {
+         throw std::invalid_argument("FittedGP: inputs and outputs differ "
+                                     "in size.");
+      }
+
+      //************************************************************************
+      // Calculate the training covariance and its Cholesky factor.
+      //************************************************************************
+      inputs_i = x;
+      Eigen::ArrayXXd cov;
+      cov_i(inputs_i,cov);
+      Eigen::LLT<Eigen::MatrixXd> llt(cov.matrix());
+      if(Eigen::Success!=llt.info())
+      {
+         throw std::runtime_error("FittedGP: training covariance is not "
+                                  "positive definite.");
+      }
+
+      //************************************************************************
+      // Store the factor and solve for alpha.
+      //************************************************************************
+      chol_i = llt.matrixL();
+      alpha_i = llt.solve(y);
+
+   } // fit
+
+   /**
+    * Calculates the predictive mean at a set of test inputs.
+    * @param[in] x the test inputs, one point per column.
+    * @param[out] mean the predictive mean for each column of \c x.
+    */
+   template<class MX, class VR> void predict(const MX& x, VR& mean)
+   {
+      Eigen::ArrayXXd cross;
+      cov_i(x,inputs_i,cross);
+      mean = cross.matrix()*alpha_i;
+   }
+
+}; // class FittedGP
+
+} // namespace gp
+} // namespace bayes
+
+#endif // BAYES_GP_FITTEDGP_H
@@ -0,0 +1,216 @@
+/**
+ * @file gp/KronSolver.h
+ * Defines the bayes::gp::KronSolver class, and functions for multiplying
+ * vectors by Kronecker products of matrices.
+ */
+#ifndef BAYES_GP_KRONSOLVER_H
+#define BAYES_GP_KRONSOLVER_H
+
+#include<cmath>
+#include<stdexcept>
+#include<vector>
+#include<Eigen/Dense>
+
+/**
+ * Namespace for all public functions and types in the bayes-cpp library.
+ */
+namespace bayes {
+
+/**
+ * Namespace for functions and types used for Gaussian Process inference.
+ */
+namespace gp {
+
+/**
+ * Multiplies a vector by the Kronecker product of a list of square matrices,
+ * \f$(A_1\otimes A_2\otimes\cdots\otimes A_D)x\f$, without forming the
+ * product. Each factor is applied in turn to a reshaped copy of the vector,
+ * so that the cost is \f$O(N\sum_d n_d)\f$, where \f$n_d\f$ is the size of
+ * factor \f$d\f$, and \f$N=\prod_d n_d\f$.
+ * @param[in] factors the matrices \f$A_1,\ldots,A_D\f$.
+ * @param[in] x vector of size \f$N\f$. The index of the last factor varies
+ * fastest, matching the ordering of the full Kronecker product.
+ * @param[in] transpose if true, multiply by the transpose of each factor.
+ * @returns the product.
+ */
+inline Eigen::VectorXd kronMultiply(const std::vector<Eigen::MatrixXd>& factors,
+                                    const Eigen::VectorXd& x,
+                                    bool transpose=false)
+{
+   typedef Eigen::MatrixXd::Index Index;
+   const Index size = x.size();
+   Eigen::VectorXd work(x);
+   Eigen::MatrixXd product;
+
+   //***************************************************************************
+   // Apply the factors from last to first. After each step, the result is
+   // transposed, so that the next factor's index varies fastest, and after
+   // all factors have been applied, the original ordering is restored.
+   //***************************************************************************
+   for(std::size_t k=factors.size(); k>0; --k)
+   {
+      const Eigen::MatrixXd& factor = factors[k-1];
+      Eigen::Map<const Eigen::MatrixXd> reshaped(work.data(),
+                                                 factor.cols(),
+                                                 size/factor.cols());
+      if(transpose)
+      {
+         product.noalias() = factor.transpose()*reshaped;
+      }
+      else
+      {
+         product.noalias() = factor*reshaped;
+      }
+      Eigen::Map<Eigen::MatrixXd>(work.data(),product.cols(),product.rows())
+         = product.transpose();
+   }
+
+   return work;
+
+} // kronMultiply
+
+/**
+ * Solves linear systems of the form \f$(A_1\otimes\cdots\otimes A_D +
+ * \sigma^2I)x=y\f$, for symmetric positive semi-definite factors
+ * \f$A_d\f$, using the eigendecomposition of each factor. If
+ * \f$A_d=Q_d\Lambda_dQ_d^T\f$, then the full matrix is
+ * \f$(\otimes_dQ_d)(\otimes_d\Lambda_d+\sigma^2I)(\otimes_dQ_d)^T\f$, so
+ * decomposition costs \f$O(\sum_dn_d^3)\f$ rather than \f$O(N^3)\f$.
+ *
+ * This covers both coregionalised models, where the factors are the
+ * output covariance \f$B\f$ and input covariance \f$K\f$, and inputs on a
+ * grid, where the covariance function is a product over dimensions (such as
+ * bayes::gp::CovSEiso), and there is one factor per dimension:
+ * \code
+ * std::vector<Eigen::MatrixXd> factors(dims);
+ * for(int d=0; d<dims; ++d)
+ * {
+ *    Eigen::ArrayXXd k;
+ *    CovSEiso(d==0 ? scale : 1.0, length)(coords[d].transpose(), k);
+ *    factors[d] = k.matrix();
+ * }
+ * KronSolver solver(factors,noiseVar);
+ * \endcode
+ */
+class KronSolver
+{
+private:
+
+   /**
+    * Eigenvectors of each factor.
+    */
+   std::vector<Eigen::MatrixXd> vectors_i;
+
+   /**
+    * Eigenvalues of the full matrix, including the noise term.
+    */
+   Eigen::VectorXd values_i;
+
+public:
+
+   /**
+    * Constructs an uninitialised solver.
+    */
+   KronSolver() {}
+
+   /**
+    * Constructs a solver for the given factors.
+    * @see compute
+    */
+   KronSolver(const std::vector<Eigen::MatrixXd>& factors, double noise)
+   {
+      compute(factors,noise);
+   }
+
+   /**
+    * Decomposes the Kronecker product of a list of factors.
+    * @param[in] factors symmetric positive semi-definite matrices
+    * \f$A_1,\ldots,A_D\f$.
+    * @param[in] noise variance \f$\sigma^2\f$ added to the diagonal.
+    * @throws std::runtime_error if the resulting matrix is not positive
+    * definite.
+    */
+   void compute(const std::vector<Eigen::MatrixXd>& factors, double noise)
+   {
+      vectors_i.resize(factors.size());
+      values_i.setOnes(1);
+
+      for(std::size_t d=0; d<factors.size(); ++d)
+      {
+         //*********************************************************************
+         // Decompose this factor
+         //*********************************************************************
+         Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigen(factors[d]);
+         if(Eigen::Success!=eigen.info())
+         {
+            throw std::runtime_error("KronSolver: eigendecomposition failed.");
+         }
+         vectors_i[d] = eigen.eigenvectors();
+
+         //*********************************************************************
+         // Take the Kronecker product of its eigenvalues with those of the
+         // previous factors.
+         //*********************************************************************
+         const Eigen::VectorXd& values = eigen.eigenvalues();
+         Eigen::VectorXd product(values_i.size()*values.size());
+         for(Eigen::MatrixXd::Index i=0; i<values_i.size(); ++i)
+         {
+            product.segment(i*values.size(),values.size()) =
+               values_i(i)*values;
+         }
+         values_i.swap(product);
+      }
+
+      values_i.array() += noise;
+      if(0 >= values_i.minCoeff())
+      {
+         throw std::runtime_error("KronSolver: matrix is not positive "
+                                  "definite.");
+      }
+
+   } // compute
+
+   /**
+    * Returns the size of the full matrix.
+    */
+   Eigen::MatrixXd::Index size() const { return values_i.size(); }
+
+   /**
+    * Returns the eigenvalues of the full matrix, including the noise term.
+    */
+   const Eigen::VectorXd& eigenvalues() const { return values_i; }
+
+   /**
+    * Returns the eigenvectors of each factor.
+    */
+   const std::vector<Eigen::MatrixXd>& eigenvectors() const
+   {
+      return vectors_i;
+   }
+
+   /**
+    * Solves the linear system for a given right hand side.
+    * @param[in] y vector with the same size as the full matrix.
+    * @returns \f$(\otimes_dA_d+\sigma^2I)^{-1}y\f$
+    */
+   Eigen::VectorXd solve(const Eigen::VectorXd& y) const
+   {
+      Eigen::VectorXd rotated = kronMultiply(vectors_i,y,true);
+      rotated.array() /= values_i.array();
+      return kronMultiply(vectors_i,rotated);
+   }
+
+   /**
+    * Returns the log determinant of the full matrix.
+    */
+   double logDeterminant() const
+   {
+      return values_i.array().log().sum();
+   }
+
+}; // class KronSolver
+
+} // namespace gp
+} // namespace bayes
+
+#endif // BAYES_GP_KRONSOLVER_H
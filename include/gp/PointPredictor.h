@@ -0,0 +1,145 @@
+/**
+ * @file gp/PointPredictor.h
+ * Defines the bayes::gp::PointPredictor class.
+ * This provides low latency prediction at single test points.
+ */
+#ifndef BAYES_GP_POINTPREDICTOR_H
+#define BAYES_GP_POINTPREDICTOR_H
+
+#include<algorithm>
+#include<stdexcept>
+#include<Eigen/Dense>
+
+/**
+ * Namespace for all public functions and types in the bayes-cpp library.
+ */
+namespace bayes {
+
+/**
+ * Namespace for functions and types used for Gaussian Process inference.
+ */
+namespace gp {
+
+/**
+ * Calculates the predictive mean of a fitted Gaussian Process at one test
+ * point at a time, with no heap allocation.
+ *
+ * The training inputs are copied into structure of arrays form, so that
+ * each input dimension is contiguous in memory. Prediction then makes a
+ * single pass over the training points in fixed size blocks: for each
+ * block, the squared distance to the test point, the covariance, and its
+ * dot product with \f$\alpha\f$ are calculated while the block is held in
+ * stack storage, using vectorised Eigen expressions.
+ * @tparam Cov the type of covariance function, which must be stationary
+ * (i.e. provide a \c fromSqDist method).
+ * @tparam D the number of input dimensions, or Eigen::Dynamic if this is
+ * only known at runtime. Fixing this at compile time allows the loop over
+ * dimensions to be unrolled.
+ */
+template<class Cov, int D=Eigen::Dynamic> class PointPredictor
+{
+public:
+
+   /**
+    * Number of training points processed in each block.
+    */
+   static const int BLOCK_SIZE = 64;
+
+private:
+
+   /**
+    * Stack allocated storage for one block of results.
+    */
+   typedef Eigen::Array<double,Eigen::Dynamic,1,Eigen::ColMajor,
+                        BLOCK_SIZE,1> Block;
+
+   /**
+    * Type used to store training inputs, with one point per row, so that
+    * each dimension is stored contiguously.
+    */
+   typedef Eigen::Matrix<double,Eigen::Dynamic,D,Eigen::ColMajor> Inputs;
+
+   /**
+    * The covariance function.
+    */
+   Cov cov_i;
+
+   /**
+    * The training inputs, one point per row.
+    */
+   Inputs inputs_i;
+
+   /**
+    * The training covariance inverse multiplied by the training outputs.
+    */
+   Eigen::VectorXd alpha_i;
+
+public:
+
+   /**
+    * Constructs a predictor for a fitted Gaussian Process.
+    * @param[in] model a fitted model, such as bayes::gp::FittedGP or
+    * bayes::gp::MappedGP, providing \c cov, \c inputs and \c alpha methods.
+    * @throws std::invalid_argument if the model inputs do not have \c D
+    * dimensions.
+    */
+   template<class Model> explicit PointPredictor(const Model& model)
+      : cov_i(model.cov()), alpha_i(model.alpha())
+   {
+      if( (Eigen::Dynamic!=D) && (D!=model.inputs().rows()) )
+      {
+         throw std::invalid_argument("PointPredictor: model inputs have "
+                                     "wrong number of dimensions.");
+      }
+      inputs_i = model.inputs().transpose();
+   }
+
+   /**
+    * Returns the number of input dimensions.
+    */
+   int dims() const { return static_cast<int>(inputs_i.cols()); }
+
+   /**
+    * Returns the predictive mean at a single test point.
+    * @param[in] x the test point, as a vector with one element per input
+    * dimension.
+    * @pre \c x has dims() elements.
+    */
+   template<class V> double operator()(const V& x) const
+   {
+      typedef typename Inputs::Index Index;
+      const Index n = alpha_i.size();
+      Block dist, cov;
+      double mean = 0;
+
+      for(Index start=0; start<n; start+=BLOCK_SIZE)
+      {
+         const Index len = std::min<Index>(BLOCK_SIZE,n-start);
+
+         //*********************************************************************
+         // Squared distance between the test point and this block.
+         //*********************************************************************
+         dist = (inputs_i.col(0).segment(start,len).array()-x(0)).square();
+         for(int d=1; d<inputs_i.cols(); ++d)
+         {
+            dist += (inputs_i.col(d).segment(start,len).array()-x(d))
+               .square();
+         }
+
+         //*********************************************************************
+         // Covariance for this block, and its contribution to the mean.
+         //*********************************************************************
+         cov_i.fromSqDist(dist,cov);
+         mean += cov.matrix().dot(alpha_i.segment(start,len));
+      }
+
+      return mean;
+
+   } // operator()
+
+}; // class PointPredictor
+
+} // namespace gp
+} // namespace bayes
+
+#endif // BAYES_GP_POINTPREDICTOR_H
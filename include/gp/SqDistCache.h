@@ -0,0 +1,163 @@
+/**
+ * @file gp/SqDistCache.h
+ * Defines the bayes::gp::SqDistCache class.
+ * This caches the squared distance between two sets of inputs, so that
+ * stationary covariance functions can be re-evaluated for different
+ * hyperparameters without recalculating the distances.
+ */
+#ifndef BAYES_GP_SQDISTCACHE_H
+#define BAYES_GP_SQDISTCACHE_H
+
+#include<gp/sqdist.h>
+
+/**
+ * Namespace for all public functions and types in the bayes-cpp library.
+ */
+namespace bayes {
+
+/**
+ * Namespace for functions and types used for Gaussian Process inference.
+ */
+namespace gp {
+
+/**
+ * Owns two sets of inputs and the squared distance between them.
+ * The distance matrix is only recalculated when the inputs change, so
+ * that repeatedly evaluating a stationary covariance function (for example,
+ * during a hyperparameter search) only costs the elementwise transform from
+ * distance to covariance.
+ * \code
+ * SqDistCache cache(trainX);
+ * for(...)
+ * {
+ *    kernel.length(nextLength);
+ *    cache(kernel,cov);
+ * }
+ * \endcode
+ */
+class SqDistCache
+{
+public:
+
+   /**
+    * Type used to store the inputs.
+    */
+   typedef Eigen::MatrixXd Inputs;
+
+   /**
+    * Type used to store the squared distances.
+    */
+   typedef Eigen::ArrayXXd Distances;
+
+private:
+
+   /**
+    * The first set of inputs, one point per column.
+    */
+   Inputs m1_i;
+
+   /**
+    * The second set of inputs, one point per column.
+    */
+   Inputs m2_i;
+
+   /**
+    * The squared distance between each column of m1_i and m2_i.
+    */
+   Distances dist_i;
+
+   /**
+    * Returns true iff \c cached and \c m have the same size and elements.
+    */
+   template<class M> static bool isSame(const Inputs& cached, const M& m)
+   {
+      if( (cached.rows()!=m.rows()) || (cached.cols()!=m.cols()) )
+      {
+         return false;
+      }
+      return (cached.array()==m.array()).all();
+   }
+
+public:
+
+   /**
+    * Constructs an empty cache.
+    */
+   SqDistCache() {}
+
+   /**
+    * Constructs a cache for the distance between two sets of inputs.
+    */
+   template<class M1, class M2> SqDistCache(const M1& m1, const M2& m2)
+   {
+      inputs(m1,m2);
+   }
+
+   /**
+    * Constructs a cache for the distance between each pair of columns in
+    * a matrix.
+    */
+   template<class M1> explicit SqDistCache(const M1& m1)
+   {
+      inputs(m1);
+   }
+
+   /**
+    * Sets the inputs for this cache. The squared distances are only
+    * recalculated if the inputs differ from those already cached.
+    * @param[in] m1 first input matrix
+    * @param[in] m2 second input matrix
+    * @returns true iff the cached distances were recalculated.
+    */
+   template<class M1, class M2> bool inputs(const M1& m1, const M2& m2)
+   {
+      if(isSame(m1_i,m1) && isSame(m2_i,m2))
+      {
+         return false;
+      }
+      m1_i = m1;
+      m2_i = m2;
+      sqdist(m1_i,m2_i,dist_i);
+      return true;
+   }
+
+   /**
+    * Sets the inputs for this cache to the columns of a single matrix.
+    * @returns true iff the cached distances were recalculated.
+    */
+   template<class M1> bool inputs(const M1& m1)
+   {
+      return inputs(m1,m1);
+   }
+
+   /**
+    * Returns the first set of cached inputs.
+    */
+   const Inputs& input1() const { return m1_i; }
+
+   /**
+    * Returns the second set of cached inputs.
+    */
+   const Inputs& input2() const { return m2_i; }
+
+   /**
+    * Returns the cached squared distances.
+    */
+   const Distances& sqDist() const { return dist_i; }
+
+   /**
+    * Evaluates a stationary covariance function between the cached inputs.
+    * @param[in] cov covariance function providing a \c fromSqDist method.
+    * @param[out] result the covariance between each pair of cached inputs.
+    */
+   template<class C, class MR> void operator()(const C& cov, MR& result) const
+   {
+      cov.fromSqDist(dist_i,result);
+   }
+
+}; // class SqDistCache
+
+} // namespace gp
+} // namespace bayes
+
+#endif // BAYES_GP_SQDISTCACHE_H
@@ -6,4 +6,7 @@
 #include "gp/CovSEiso.h"
 #include "gp/CovNoise.h"
 #include "gp/CovSum.h"
+#include "gp/CovCoreg.h"
+#include "gp/CovHandle.h"
+#include "gp/SqDistCache.h"
 
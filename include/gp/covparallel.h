@@ -0,0 +1,28 @@
+/**
+ * @file gp/covparallel.h
+ * Defines constants controlling parallel evaluation of covariance functions.
+ */
+#ifndef BAYES_GP_COVPARALLEL_H
+#define BAYES_GP_COVPARALLEL_H
+
+/**
+ * Namespace for all public functions and types in the bayes-cpp library.
+ */
+namespace bayes {
+
+/**
+ * Namespace for functions and types used for Gaussian Process inference.
+ */
+namespace gp {
+
+/**
+ * Minimum number of elements in a result before elementwise covariance
+ * transforms are split between threads. Below this, the cost of starting
+ * threads outweighs the benefit. Only used if compiled with OpenMP.
+ */
+const int PARALLEL_MIN_SIZE = 16384;
+
+} // namespace gp
+} // namespace bayes
+
+#endif // BAYES_GP_COVPARALLEL_H
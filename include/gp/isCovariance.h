@@ -0,0 +1,32 @@
+/**
+ * @file gp/isCovariance.h
+ * Defines the bayes::gp::isCovariance trait class.
+ */
+#ifndef BAYES_GP_ISCOVARIANCE_H
+#define BAYES_GP_ISCOVARIANCE_H
+
+#include<boost/type_traits/integral_constant.hpp>
+
+/**
+ * Namespace for all public functions and types in the bayes-cpp library.
+ */
+namespace bayes {
+
+/**
+ * Namespace for functions and types used for Gaussian Process inference.
+ */
+namespace gp {
+
+/**
+ * Trait class identifying covariance function types, so that operator+
+ * only applies to covariance functions, and not (for example) to Eigen
+ * expressions or strings. Each covariance function class that can be
+ * summed with the others should specialise this to inherit from
+ * boost::true_type, in the same header that defines the class.
+ */
+template<class C> struct isCovariance : boost::false_type {};
+
+} // namespace gp
+} // namespace bayes
+
+#endif // BAYES_GP_ISCOVARIANCE_H
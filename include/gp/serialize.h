@@ -0,0 +1,821 @@
+/**
+ * @file gp/serialize.h
+ * Defines functions for saving and loading fitted Gaussian Processes in a
+ * compact, versioned binary format.
+ *
+ * A file consists of a fixed size header, followed by the covariance
+ * function and the fitted state of the model:
+ *
+ * | Offset | Type          | Contents                                    |
+ * |--------|---------------|---------------------------------------------|
+ * | 0      | char[8]       | magic string "BAYESGP"                      |
+ * | 8      | uint32        | format version (bayes::gp::GP_FILE_VERSION) |
+ * | 12     | uint32        | size in bytes of covariance section         |
+ * | 16     | uint64        | input dimensions \f$d\f$                    |
+ * | 24     | uint64        | number of training points \f$n\f$           |
+ * | 32     | -             | covariance section, padded to 8 bytes       |
+ * | -      | double[d*n]   | training inputs (column major)              |
+ * | -      | double[n*n]   | Cholesky factor (column major)              |
+ * | -      | double[n]     | alpha                                       |
+ *
+ * The covariance section is a tree of records, each consisting of a uint32
+ * type tag and a uint32 parameter count, followed by that many doubles.
+ * Composite covariance functions, such as bayes::gp::CovSum, are followed
+ * by the records for their components. Hyperparameters are stored exactly
+ * as they are held in memory (for example, bayes::gp::CovSEiso's log scale),
+ * so that a loaded model gives identical predictions. All values are stored in native
+ * byte order, and every matrix starts on an 8 byte boundary, so that a
+ * memory mapped file can be used directly by bayes::gp::MappedGP.
+ */
+#ifndef BAYES_GP_SERIALIZE_H
+#define BAYES_GP_SERIALIZE_H
+
+#include<cerrno>
+#include<cstring>
+#include<cstdint>
+#include<fstream>
+#include<limits>
+#include<new>
+#include<sstream>
+#include<stdexcept>
+#include<string>
+#include<utility>
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#include<gp/CovSEiso.h>
+#include<gp/CovNoise.h>
+#include<gp/CovSum.h>
+#include<gp/FittedGP.h>
+
+/**
+ * Namespace for all public functions and types in the bayes-cpp library.
+ */
+namespace bayes {
+
+/**
+ * Namespace for functions and types used for Gaussian Process inference.
+ */
+namespace gp {
+
+/**
+ * Magic string identifying a saved Gaussian Process.
+ */
+const char GP_FILE_MAGIC[8] = {'B','A','Y','E','S','G','P','\0'};
+
+/**
+ * Current version of the saved Gaussian Process format.
+ * Files with any other version are rejected when loaded.
+ */
+const std::uint32_t GP_FILE_VERSION = 2;
+
+/**
+ * Type tags identifying each covariance function in a saved file.
+ * Existing values must not be changed, or saved files will be invalidated.
+ */
+enum CovTag
+{
+   COV_TAG_SEISO = 1, ///< bayes::gp::CovSEiso
+   COV_TAG_NOISE = 2, ///< bayes::gp::CovNoise
+   COV_TAG_SUM   = 3  ///< bayes::gp::CovSum
+};
+
+/**
+ * Writes the binary representation of a plain old data value to a stream.
+ */
+template<class T> void writePod(std::ostream& out, const T& value)
+{
+   out.write(reinterpret_cast<const char*>(&value),sizeof(T));
+}
+
+/**
+ * Reads values sequentially from a buffer of bytes, checking that no read
+ * goes past the end of the buffer.
+ */
+class ByteReader
+{
+private:
+
+   /**
+    * Current read position.
+    */
+   const char* pos_i;
+
+   /**
+    * End of the buffer.
+    */
+   const char* end_i;
+
+public:
+
+   /**
+    * Constructs a reader for the buffer [begin,end).
+    */
+   ByteReader(const char* begin, const char* end)
+      : pos_i(begin), end_i(end) {}
+
+   /**
+    * Returns the number of unread bytes.
+    */
+   std::size_t remaining() const { return end_i-pos_i; }
+
+   /**
+    * Returns a pointer to the next \c bytes bytes, and skips past them.
+    * @throws std::runtime_error if fewer than \c bytes bytes remain.
+    */
+   const char* skip(std::size_t bytes)
+   {
+      if(remaining()<bytes)
+      {
+         throw std::runtime_error("Truncated Gaussian Process file.");
+      }
+      const char* result = pos_i;
+      pos_i += bytes;
+      return result;
+   }
+
+   /**
+    * Reads a plain old data value.
+    */
+   template<class T> T pod()
+   {
+      T result;
+      std::memcpy(&result,skip(sizeof(T)),sizeof(T));
+      return result;
+   }
+
+   /**
+    * Checks that only zero padding remains unread.
+    * @throws std::runtime_error if any other bytes remain.
+    */
+   void checkPadding() const
+   {
+      if(sizeof(double)<=remaining())
+      {
+         throw std::runtime_error("Corrupt Gaussian Process file.");
+      }
+      for(const char* p=pos_i; p!=end_i; ++p)
+      {
+         if('\0'!=*p)
+         {
+            throw std::runtime_error("Corrupt Gaussian Process file.");
+         }
+      }
+   }
+
+   /**
+    * Reads a covariance record header, checking that it has the expected
+    * type tag and number of parameters.
+    * @throws std::runtime_error if the record does not match.
+    */
+   void covRecord(std::uint32_t tag, std::uint32_t paramCount)
+   {
+      const std::uint32_t fileTag = pod<std::uint32_t>();
+      const std::uint32_t fileCount = pod<std::uint32_t>();
+      if( (fileTag!=tag) || (fileCount!=paramCount) )
+      {
+         throw std::runtime_error("Saved covariance function does not match "
+                                  "requested type.");
+      }
+   }
+
+}; // class ByteReader
+
+/**
+ * Trait class defining how each type of covariance function is saved and
+ * loaded. Specialisations must define static \c write and \c read functions.
+ */
+template<class C> struct CovIO;
+
+/**
+ * Saves and loads bayes::gp::CovSEiso.
+ */
+template<> struct CovIO<CovSEiso>
+{
+   /**
+    * Writes the covariance function to a stream.
+    */
+   static void write(std::ostream& out, const CovSEiso& cov)
+   {
+      writePod<std::uint32_t>(out,COV_TAG_SEISO);
+      writePod<std::uint32_t>(out,2);
+      writePod(out,cov.logScale());
+      writePod(out,cov.length());
+   }
+
+   /**
+    * Reads the covariance function from a buffer.
+    */
+   static CovSEiso read(ByteReader& in)
+   {
+      in.covRecord(COV_TAG_SEISO,2);
+      CovSEiso cov;
+      cov.logScale(in.pod<double>());
+      cov.length(in.pod<double>());
+      return cov;
+   }
+};
+
+/**
+ * Saves and loads bayes::gp::CovNoise.
+ */
+template<> struct CovIO<CovNoise>
+{
+   /**
+    * Writes the covariance function to a stream.
+    */
+   static void write(std::ostream& out, const CovNoise& cov)
+   {
+      writePod<std::uint32_t>(out,COV_TAG_NOISE);
+      writePod<std::uint32_t>(out,1);
+      writePod(out,cov.var());
+   }
+
+   /**
+    * Reads the covariance function from a buffer.
+    */
+   static CovNoise read(ByteReader& in)
+   {
+      in.covRecord(COV_TAG_NOISE,1);
+      return CovNoise(in.pod<double>());
+   }
+};
+
+/**
+ * Saves and loads bayes::gp::CovSum, by recursively saving and loading its
+ * components.
+ */
+template<class C1, class C2> struct CovIO< CovSum<C1,C2> >
+{
+   /**
+    * Writes the covariance function to a stream.
+    */
+   static void write(std::ostream& out, const CovSum<C1,C2>& cov)
+   {
+      writePod<std::uint32_t>(out,COV_TAG_SUM);
+      writePod<std::uint32_t>(out,0);
+      CovIO<C1>::write(out,cov.cov1());
+      CovIO<C2>::write(out,cov.cov2());
+   }
+
+   /**
+    * Reads the covariance function from a buffer.
+    */
+   static CovSum<C1,C2> read(ByteReader& in)
+   {
+      in.covRecord(COV_TAG_SUM,0);
+      C1 cov1 = CovIO<C1>::read(in);
+      C2 cov2 = CovIO<C2>::read(in);
+      return CovSum<C1,C2>(cov1,cov2);
+   }
+};
+
+/**
+ * Fixed size header at the start of a saved Gaussian Process.
+ */
+struct GPFileHeader
+{
+   /**
+    * Size of the header in bytes.
+    */
+   static const std::size_t SIZE = 32;
+
+   /**
+    * Size in bytes of the covariance section, including padding.
+    */
+   std::uint32_t covBytes;
+
+   /**
+    * Number of input dimensions.
+    */
+   std::uint64_t dims;
+
+   /**
+    * Number of training points.
+    */
+   std::uint64_t n;
+
+   /**
+    * Writes this header to a stream.
+    */
+   void write(std::ostream& out) const
+   {
+      out.write(GP_FILE_MAGIC,sizeof(GP_FILE_MAGIC));
+      writePod(out,GP_FILE_VERSION);
+      writePod(out,covBytes);
+      writePod(out,dims);
+      writePod(out,n);
+   }
+
+   /**
+    * Reads a header from a buffer, checking its magic string and version.
+    * @throws std::runtime_error if the header is invalid.
+    */
+   void read(ByteReader& in)
+   {
+      if(0!=std::memcmp(in.skip(sizeof(GP_FILE_MAGIC)),GP_FILE_MAGIC,
+                        sizeof(GP_FILE_MAGIC)))
+      {
+         throw std::runtime_error("Not a saved Gaussian Process file.");
+      }
+      if(GP_FILE_VERSION!=in.pod<std::uint32_t>())
+      {
+         throw std::runtime_error("Unsupported Gaussian Process file version.");
+      }
+      covBytes = in.pod<std::uint32_t>();
+      dims = in.pod<std::uint64_t>();
+      n = in.pod<std::uint64_t>();
+      if(0!=covBytes%sizeof(double))
+      {
+         throw std::runtime_error("Corrupt Gaussian Process file.");
+      }
+   }
+
+   /**
+    * Returns the number of doubles stored after the covariance section,
+    * checking that they fit in \c maxBytes bytes, and that each dimension
+    * can be stored in an Eigen index.
+    * @throws std::runtime_error if they do not fit.
+    */
+   std::uint64_t dataSize(std::uint64_t maxBytes) const
+   {
+      //************************************************************************
+      // Add each term in turn, checking against the remaining space, so that
+      // neither the terms nor their sum can overflow.
+      //************************************************************************
+      const std::uint64_t maxIndex =
+         std::numeric_limits<Eigen::MatrixXd::Index>::max();
+      if( (n>maxIndex) || (dims>maxIndex) )
+      {
+         throw std::runtime_error("Corrupt Gaussian Process file.");
+      }
+      const std::uint64_t maxDoubles = maxBytes/sizeof(double);
+      if(n>maxDoubles)
+      {
+         throw std::runtime_error("Truncated Gaussian Process file.");
+      }
+      std::uint64_t count = n;
+      if(0<n)
+      {
+         if(n>(maxDoubles-count)/n)
+         {
+            throw std::runtime_error("Truncated Gaussian Process file.");
+         }
+         count += n*n;
+         if(dims>(maxDoubles-count)/n)
+         {
+            throw std::runtime_error("Truncated Gaussian Process file.");
+         }
+         count += dims*n;
+      }
+      return count;
+   }
+
+   /**
+    * Returns the number of doubles stored after the covariance section,
+    * checking that it matches the number of bytes available.
+    * @throws std::runtime_error if the sizes do not match.
+    */
+   std::uint64_t checkDataSize(std::uint64_t bytes) const
+   {
+      const std::uint64_t count = dataSize(bytes);
+      if(count*sizeof(double)!=bytes)
+      {
+         throw std::runtime_error("Gaussian Process file has wrong size.");
+      }
+      return count;
+   }
+
+}; // struct GPFileHeader
+
+/**
+ * Saves a fitted Gaussian Process to a stream.
+ * @param[out] out binary output stream.
+ * @param[in] gp the Gaussian Process to save.
+ * @throws std::runtime_error if writing fails.
+ */
+template<class Cov> void save(std::ostream& out, const FittedGP<Cov>& gp)
+{
+   //***************************************************************************
+   // Serialise the covariance function first, so that we know its size,
+   // and pad it so that the following matrices are aligned.
+   //***************************************************************************
+   std::ostringstream covOut;
+   CovIO<Cov>::write(covOut,gp.cov());
+   std::string covBytes = covOut.str();
+   covBytes.resize((covBytes.size()+sizeof(double)-1) & ~(sizeof(double)-1),
+                   '\0');
+
+   //***************************************************************************
+   // Write the header and covariance function.
+   //***************************************************************************
+   GPFileHeader header;
+   header.covBytes = static_cast<std::uint32_t>(covBytes.size());
+   header.dims = gp.inputs().rows();
+   header.n = gp.inputs().cols();
+   header.write(out);
+   out.write(covBytes.data(),covBytes.size());
+
+   //***************************************************************************
+   // Write the fitted state.
+   //***************************************************************************
+   out.write(reinterpret_cast<const char*>(gp.inputs().data()),
+             gp.inputs().size()*sizeof(double));
+   out.write(reinterpret_cast<const char*>(gp.chol().data()),
+             gp.chol().size()*sizeof(double));
+   out.write(reinterpret_cast<const char*>(gp.alpha().data()),
+             gp.alpha().size()*sizeof(double));
+
+   if(!out)
+   {
+      throw std::runtime_error("Failed to write Gaussian Process.");
+   }
+
+} // save
+
+/**
+ * Saves a fitted Gaussian Process to a file.
+ * @param[in] filename name of file to create or overwrite.
+ * @param[in] gp the Gaussian Process to save.
+ * @throws std::runtime_error if the file cannot be written.
+ */
+template<class Cov>
+void save(const std::string& filename, const FittedGP<Cov>& gp)
+{
+   std::ofstream out(filename.c_str(),std::ios::binary|std::ios::trunc);
+   if(!out)
+   {
+      throw std::runtime_error("Cannot open file for writing: "+filename);
+   }
+   save(out,gp);
+}
+
+/**
+ * Loads a fitted Gaussian Process from a stream, copying its contents into
+ * memory. To use a saved file without copying, see bayes::gp::MappedGP.
+ * @param[in] in binary input stream. If this is seekable, it must end
+ * immediately after the saved Gaussian Process, and its sizes are checked
+ * against the stream length before any memory is allocated. Otherwise,
+ * memory for the sizes stored in the header is allocated before reading,
+ * so a corrupt header may cause a large allocation before the stream is
+ * found to be truncated.
+ * @returns the loaded Gaussian Process.
+ * @throws std::runtime_error if the stream does not contain a valid
+ * Gaussian Process, with covariance function of type \c Cov, or if
+ * memory for its stored sizes cannot be allocated.
+ */
+template<class Cov> FittedGP<Cov> load(std::istream& in)
+{
+   //***************************************************************************
+   // Read the header
+   //***************************************************************************
+   char headerBytes[GPFileHeader::SIZE];
+   if(!in.read(headerBytes,sizeof(headerBytes)))
+   {
+      throw std::runtime_error("Truncated Gaussian Process file.");
+   }
+   ByteReader headerReader(headerBytes,headerBytes+sizeof(headerBytes));
+   GPFileHeader header;
+   header.read(headerReader);
+
+   //***************************************************************************
+   // Read the covariance function.
+   //***************************************************************************
+   std::string covBytes(header.covBytes,'\0');
+   if(!in.read(&covBytes[0],covBytes.size()))
+   {
+      throw std::runtime_error("Truncated Gaussian Process file.");
+   }
+   ByteReader covReader(covBytes.data(),covBytes.data()+covBytes.size());
+   Cov cov = CovIO<Cov>::read(covReader);
+   covReader.checkPadding();
+
+   //***************************************************************************
+   // Check the size of the fitted state before allocating it. If the stream
+   // is seekable, it must contain exactly that much data, otherwise we can
+   // only check that the size is representable.
+   //***************************************************************************
+   const std::istream::pos_type dataStart = in.tellg();
+   if(std::istream::pos_type(-1)!=dataStart)
+   {
+      in.seekg(0,std::ios::end);
+      const std::istream::pos_type dataEnd = in.tellg();
+      in.seekg(dataStart);
+      if( (std::istream::pos_type(-1)==dataEnd) || !in )
+      {
+         throw std::runtime_error("Failed to read Gaussian Process.");
+      }
+      header.checkDataSize(dataEnd-dataStart);
+   }
+   else
+   {
+      header.dataSize(std::numeric_limits<std::size_t>::max());
+   }
+
+   //***************************************************************************
+   // Read the fitted state directly into its final storage. The largest
+   // matrix is allocated first, so that an impossible size fails before
+   // anything else is allocated.
+   //***************************************************************************
+   Eigen::MatrixXd inputs, chol;
+   Eigen::VectorXd alpha;
+   try
+   {
+      chol.resize(header.n,header.n);
+      inputs.resize(header.dims,header.n);
+      alpha.resize(header.n);
+   }
+   catch(std::bad_alloc&)
+   {
+      throw std::runtime_error("Gaussian Process file too large to load.");
+   }
+   in.read(reinterpret_cast<char*>(inputs.data()),
+           inputs.size()*sizeof(double));
+   in.read(reinterpret_cast<char*>(chol.data()),chol.size()*sizeof(double));
+   in.read(reinterpret_cast<char*>(alpha.data()),alpha.size()*sizeof(double));
+   if(!in)
+   {
+      throw std::runtime_error("Truncated Gaussian Process file.");
+   }
+
+   return FittedGP<Cov>(cov,inputs,chol,alpha);
+
+} // load
+
+/**
+ * Loads a fitted Gaussian Process from a file, copying its contents into
+ * memory. To use a saved file without copying, see bayes::gp::MappedGP.
+ * @param[in] filename name of file to read.
+ * @throws std::runtime_error if the file cannot be read, or does not
+ * contain a valid Gaussian Process with covariance function of type \c Cov.
+ */
+template<class Cov> FittedGP<Cov> load(const std::string& filename)
+{
+   std::ifstream in(filename.c_str(),std::ios::binary);
+   if(!in)
+   {
+      throw std::runtime_error("Cannot open file for reading: "+filename);
+   }
+   return load<Cov>(in);
+}
+
+/**
+ * A fitted Gaussian Process backed by a memory mapped file, as written by
+ * bayes::gp::save. The training inputs, Cholesky factor and alpha are
+ * accessed in place through Eigen::Map, so construction only reads the
+ * header and covariance function, regardless of the number of training
+ * points. Pages are loaded from disk by the operating system as they are
+ * first used.
+ * @tparam Cov the type of covariance function.
+ */
+template<class Cov> class MappedGP
+{
+public:
+
+   /**
+    * Read only view of a mapped matrix.
+    */
+   typedef Eigen::Map<const Eigen::MatrixXd> MatrixMap;
+
+   /**
+    * Read only view of a mapped vector.
+    */
+   typedef Eigen::Map<const Eigen::VectorXd> VectorMap;
+
+private:
+
+   /**
+    * Start of the mapped file.
+    */
+   void* addr_i;
+
+   /**
+    * Size of the mapped file in bytes.
+    */
+   std::size_t bytes_i;
+
+   /**
+    * The covariance function.
+    */
+   Cov cov_i;
+
+   /**
+    * Number of input dimensions.
+    */
+   Eigen::MatrixXd::Index dims_i;
+
+   /**
+    * Number of training points.
+    */
+   Eigen::MatrixXd::Index n_i;
+
+   /**
+    * Start of the training inputs in the mapped file.
+    */
+   const double* inputs_i;
+
+   /**
+    * Start of the Cholesky factor in the mapped file.
+    */
+   const double* chol_i;
+
+   /**
+    * Start of alpha in the mapped file.
+    */
+   const double* alpha_i;
+
+   /**
+    * Parses the mapped file, and sets the covariance function and
+    * pointers to the fitted state.
+    */
+   void parse()
+   {
+      const char* begin = static_cast<const char*>(addr_i);
+      ByteReader in(begin,begin+bytes_i);
+      GPFileHeader header;
+      header.read(in);
+      ByteReader covReader(in.skip(header.covBytes),
+                           begin+GPFileHeader::SIZE+header.covBytes);
+      cov_i = CovIO<Cov>::read(covReader);
+      covReader.checkPadding();
+      header.checkDataSize(in.remaining());
+
+      dims_i = header.dims;
+      n_i = header.n;
+      inputs_i = reinterpret_cast<const double*>(in.skip(0));
+      chol_i = inputs_i + dims_i*n_i;
+      alpha_i = chol_i + n_i*n_i;
+   }
+
+   /**
+    * Unmaps the file, unless this object is empty.
+    */
+   void unmap()
+   {
+      if(MAP_FAILED!=addr_i)
+      {
+         ::munmap(addr_i,bytes_i);
+      }
+   }
+
+   /**
+    * Forgets the mapping without unmapping it, leaving this object empty.
+    */
+   void release()
+   {
+      addr_i = MAP_FAILED;
+      bytes_i = 0;
+      dims_i = 0;
+      n_i = 0;
+      inputs_i = 0;
+      chol_i = 0;
+      alpha_i = 0;
+   }
+
+public:
+
+   /**
+    * Maps a saved Gaussian Process into memory.
+    * @param[in] filename name of file written by bayes::gp::save.
+    * @throws std::runtime_error if the file cannot be mapped, or does not
+    * contain a valid Gaussian Process with covariance function of type
+    * \c Cov.
+    */
+   explicit MappedGP(const std::string& filename)
+      : addr_i(MAP_FAILED), bytes_i(0), dims_i(0), n_i(0),
+        inputs_i(0), chol_i(0), alpha_i(0)
+   {
+      //************************************************************************
+      // Map the file. The descriptor is not needed once the mapping exists.
+      //************************************************************************
+      int fd = ::open(filename.c_str(),O_RDONLY);
+      if(0>fd)
+      {
+         throw std::runtime_error("Cannot open "+filename+": "+
+                                  std::string(std::strerror(errno)));
+      }
+      struct stat info;
+      if(0!=::fstat(fd,&info) ||
+         static_cast<std::size_t>(info.st_size)<GPFileHeader::SIZE)
+      {
+         ::close(fd);
+         throw std::runtime_error("Not a saved Gaussian Process file: "+
+                                  filename);
+      }
+      bytes_i = info.st_size;
+      addr_i = ::mmap(0,bytes_i,PROT_READ,MAP_PRIVATE,fd,0);
+      const int mapError = errno;
+      ::close(fd);
+      if(MAP_FAILED==addr_i)
+      {
+         throw std::runtime_error("Cannot map "+filename+": "+
+                                  std::string(std::strerror(mapError)));
+      }
+
+      //************************************************************************
+      // Parse the contents, releasing the mapping if they are invalid.
+      //************************************************************************
+      try
+      {
+         parse();
+      }
+      catch(...)
+      {
+         ::munmap(addr_i,bytes_i);
+         throw;
+      }
+
+   } // MappedGP
+
+   /**
+    * Takes over another object's mapping, leaving it empty. The other
+    * object may then only be assigned to or destroyed.
+    */
+   MappedGP(MappedGP&& other)
+      : addr_i(other.addr_i), bytes_i(other.bytes_i),
+        cov_i(std::move(other.cov_i)), dims_i(other.dims_i), n_i(other.n_i),
+        inputs_i(other.inputs_i), chol_i(other.chol_i), alpha_i(other.alpha_i)
+   {
+      other.release();
+   }
+
+   /**
+    * Unmaps this object's file, and takes over another object's mapping,
+    * leaving it empty. The other object may then only be assigned to or
+    * destroyed.
+    */
+   MappedGP& operator=(MappedGP&& other)
+   {
+      if(this!=&other)
+      {
+         unmap();
+         addr_i = other.addr_i;
+         bytes_i = other.bytes_i;
+         cov_i = std::move(other.cov_i);
+         dims_i = other.dims_i;
+         n_i = other.n_i;
+         inputs_i = other.inputs_i;
+         chol_i = other.chol_i;
+         alpha_i = other.alpha_i;
+         other.release();
+      }
+      return *this;
+   }
+
+   /**
+    * Unmaps the file.
+    */
+   ~MappedGP()
+   {
+      unmap();
+   }
+
+   /**
+    * Mapped files cannot be copied.
+    */
+   MappedGP(const MappedGP&) = delete;
+
+   /**
+    * Mapped files cannot be copied.
+    */
+   MappedGP& operator=(const MappedGP&) = delete;
+
+   /**
+    * Returns a reference to the covariance function.
+    */
+   const Cov& cov() const { return cov_i; }
+
+   /**
+    * Returns the training inputs, one point per column.
+    */
+   MatrixMap inputs() const { return MatrixMap(inputs_i,dims_i,n_i); }
+
+   /**
+    * Returns the lower triangular Cholesky factor of the training covariance.
+    */
+   MatrixMap chol() const { return MatrixMap(chol_i,n_i,n_i); }
+
+   /**
+    * Returns the training covariance inverse times the training outputs.
+    */
+   VectorMap alpha() const { return VectorMap(alpha_i,n_i); }
+
+   /**
+    * Calculates the predictive mean at a set of test inputs.
+    * @param[in] x the test inputs, one point per column.
+    * @param[out] mean the predictive mean for each column of \c x.
+    */
+   template<class MX, class VR> void predict(const MX& x, VR& mean)
+   {
+      Eigen::ArrayXXd cross;
+      cov_i(x,inputs(),cross);
+      mean = cross.matrix()*alpha();
+   }
+
+}; // class MappedGP
+
+} // namespace gp
+} // namespace bayes
+
+#endif // BAYES_GP_SERIALIZE_H
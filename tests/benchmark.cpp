@@ -0,0 +1,224 @@
+/**
+ * @file benchmark.cpp
+ * Timing benchmarks. Results are only meaningful for optimised builds, so
+ * CMake always compiles this with -O3, regardless of CMAKE_BUILD_TYPE.
+ *
+ * Single point prediction with n=500 and d=4 is aimed at under 1 us, and
+ * the benchmark reports whether this target is met. Its cost is dominated
+ * by evaluating exp once per training point.
+ */
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <utility>
+#include <Eigen/Dense>
+#include "gp/cov.h"
+#include "gp/FittedGP.h"
+#include "gp/PointPredictor.h"
+#include "gp/CovParser.h"
+
+/**
+ * Module namespace.
+ */
+namespace {
+
+/**
+ * Clock used for all timings.
+ */
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * Returns the number of nanoseconds elapsed since \c start.
+ */
+double nanosSince(Clock::time_point start)
+{
+   return std::chrono::duration<double,std::nano>(Clock::now()-start).count();
+}
+
+/**
+ * Value accumulated from every benchmark result, so that the compiler
+ * cannot optimise away the work being timed.
+ */
+double checksum = 0;
+
+/**
+ * Compares single point prediction using bayes::gp::PointPredictor with
+ * the generic bayes::gp::FittedGP::predict method.
+ */
+void benchPointPredictor()
+{
+   using namespace Eigen;
+   using namespace bayes::gp;
+   typedef CovSum<CovSEiso,CovNoise> Kernel;
+   const int DIMS = 4;
+   const int TRAIN = 500;
+   const int TEST = 1000;
+   const int REPEATS = 200;
+   const double TARGET = 1000; // nanoseconds per point prediction
+
+   //***************************************************************************
+   // Fit a Gaussian Process, and generate test points.
+   //***************************************************************************
+   MatrixXd x(MatrixXd::Random(DIMS,TRAIN));
+   VectorXd y(VectorXd::Random(TRAIN));
+   MatrixXd test(MatrixXd::Random(DIMS,TEST));
+   FittedGP<Kernel> gp(CovSEiso(1.0,0.5)+CovNoise(0.01));
+   gp.fit(x,y);
+   PointPredictor<Kernel,DIMS> predictor(gp);
+
+   //***************************************************************************
+   // Time the generic path, one point at a time.
+   //***************************************************************************
+   VectorXd mean;
+   Clock::time_point start = Clock::now();
+   for(int r=0; r<REPEATS; ++r)
+   {
+      for(int i=0; i<TEST; ++i)
+      {
+         gp.predict(test.col(i),mean);
+         checksum += mean(0);
+      }
+   }
+   const double generic = nanosSince(start)/(REPEATS*TEST);
+
+   //***************************************************************************
+   // Time the point predictor.
+   //***************************************************************************
+   start = Clock::now();
+   for(int r=0; r<REPEATS; ++r)
+   {
+      for(int i=0; i<TEST; ++i)
+      {
+         checksum += predictor(test.col(i));
+      }
+   }
+   const double point = nanosSince(start)/(REPEATS*TEST);
+
+   std::cout << "Single point prediction (n=" << TRAIN << ", d=" << DIMS
+      << "):\n"
+      << "   FittedGP::predict: " << generic << " ns\n"
+      << "   PointPredictor:    " << point << " ns (target " << TARGET
+      << " ns, " << (point<TARGET ? "met" : "not met") << ")" << std::endl;
+
+} // function benchPointPredictor
+
+/**
+ * Returns the fastest time in nanoseconds to evaluate a covariance function
+ * between two sets of points, both directly and from cached distances.
+ * Taking the fastest of several calls, rather than the mean, discards
+ * interruptions from the rest of the system.
+ */
+template<class Cov> std::pair<double,double> timeCov(Cov& cov,
+                                                     const Eigen::MatrixXd& m1,
+                                                     const Eigen::MatrixXd& m2,
+                                                     int repeats)
+{
+   using namespace bayes::gp;
+   Eigen::ArrayXXd result;
+   SqDistCache cache(m1,m2);
+
+   double direct = 1e300;
+   for(int r=0; r<repeats; ++r)
+   {
+      Clock::time_point start = Clock::now();
+      cov(m1,m2,result);
+      direct = std::min(direct,nanosSince(start));
+      checksum += result(0,0);
+   }
+
+   double cached = 1e300;
+   for(int r=0; r<repeats; ++r)
+   {
+      Clock::time_point start = Clock::now();
+      cache(cov,result);
+      cached = std::min(cached,nanosSince(start));
+      checksum += result(0,0);
+   }
+
+   return std::make_pair(direct,cached);
+}
+
+/**
+ * Compares a compile time covariance function with the same function
+ * constructed at runtime by bayes::gp::parseCov. The runtime handle adds a
+ * few virtual calls per evaluation, so differences of a few percent either
+ * way are measurement noise.
+ */
+void benchCovHandle()
+{
+   using namespace Eigen;
+   using namespace bayes::gp;
+   const int POINTS = 400;
+   const int REPEATS = 100;
+   const int ROUNDS = 6;
+
+   MatrixXd m1(MatrixXd::Random(4,POINTS));
+   MatrixXd m2(MatrixXd::Random(4,POINTS));
+   auto templated = CovSEiso(1.0,0.5)+CovNoise(0.01)+CovSEiso(0.2,3.0);
+   CovHandle runtime =
+      parseCov("CovSEiso(1.0,0.5) + CovNoise(0.01) + CovSEiso(0.2,3.0)");
+
+   //***************************************************************************
+   // Alternate which of the two runs first in each round, so that neither
+   // benefits from warm caches or changes in clock speed, and take the
+   // fastest round for each.
+   //***************************************************************************
+   std::pair<double,double> templatedTime(1e300,1e300);
+   std::pair<double,double> runtimeTime(1e300,1e300);
+   for(int round=0; round<ROUNDS; ++round)
+   {
+      std::pair<double,double> t, r;
+      if(0==round%2)
+      {
+         t = timeCov(templated,m1,m2,REPEATS);
+         r = timeCov(runtime,m1,m2,REPEATS);
+      }
+      else
+      {
+         r = timeCov(runtime,m1,m2,REPEATS);
+         t = timeCov(templated,m1,m2,REPEATS);
+      }
+      templatedTime.first = std::min(templatedTime.first,t.first);
+      templatedTime.second = std::min(templatedTime.second,t.second);
+      runtimeTime.first = std::min(runtimeTime.first,r.first);
+      runtimeTime.second = std::min(runtimeTime.second,r.second);
+   }
+   const double templatedDirect = templatedTime.first;
+   const double templatedCached = templatedTime.second;
+   const double runtimeDirect = runtimeTime.first;
+   const double runtimeCached = runtimeTime.second;
+
+   std::cout << "Covariance evaluation (" << POINTS << "x" << POINTS
+      << ", SEiso+Noise+SEiso):\n"
+      << "   templated: " << templatedDirect/1000 << " us, cached "
+      << templatedCached/1000 << " us\n"
+      << "   runtime:   " << runtimeDirect/1000 << " us, cached "
+      << runtimeCached/1000 << " us\n"
+      << "   runtime overhead: "
+      << 100*(runtimeDirect/templatedDirect-1) << "%, cached "
+      << 100*(runtimeCached/templatedCached-1) << "%" << std::endl;
+
+} // function benchCovHandle
+
+} // module namespace
+
+/**
+ * Runs all benchmarks.
+ */
+int main()
+{
+   try
+   {
+      benchPointPredictor();
+      benchCovHandle();
+   }
+   catch(std::exception& e)
+   {
+      std::cout << "Caught error: " << e.what() << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   std::cout << "Checksum: " << checksum << std::endl;
+   return EXIT_SUCCESS;
+}
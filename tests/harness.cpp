@@ -4,10 +4,25 @@
  */
 #include <boost/typeof/typeof.hpp>
 #include <boost/typeof/std/utility.hpp>
+#include <clocale>
+#include <cstdint>
+#include <cstring>
 #include <exception>
+#include <fstream>
 #include <iostream>
+#include <locale>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <Eigen/Dense>
 #include "gp/cov.h"
+#include "gp/serialize.h"
+#include "gp/PointPredictor.h"
+#include "gp/KronSolver.h"
+#include "gp/CoregGP.h"
+#include "gp/CovParser.h"
 
 /**
  * Module namespace.
@@ -125,6 +140,651 @@ int testSEiso()
 
 } // function testSEiso
 
+/**
+ * Test that the squared distance cache gives the same covariance as
+ * direct evaluation, and is only recalculated when its inputs change.
+ */
+int testSqDistCache()
+{
+   using namespace Eigen;
+   using namespace bayes::gp;
+
+   //***************************************************************************
+   // Create test matrices
+   //***************************************************************************
+   MatrixXd m1(MatrixXd::Random(3,20));
+   MatrixXd m2(MatrixXd::Random(3,15));
+
+   //***************************************************************************
+   // Create cache, and check that it is only recalculated when required.
+   //***************************************************************************
+   SqDistCache cache(m1,m2);
+   if(cache.inputs(m1,m2))
+   {
+      std::cout << "Cache recalculated for unchanged inputs" << std::endl;
+      return EXIT_FAILURE;
+   }
+   if(!cache.inputs(m1))
+   {
+      std::cout << "Cache not recalculated for changed inputs" << std::endl;
+      return EXIT_FAILURE;
+   }
+   cache.inputs(m1,m2);
+
+   //***************************************************************************
+   // Compare direct and cached covariance for different hyperparameters.
+   //***************************************************************************
+   CovSEiso iso(1,1);
+   auto sum = iso+CovNoise(0.5);
+   Array<double,Dynamic,Dynamic> direct, cached;
+   for(int i=1; i<=5; ++i)
+   {
+      iso.scale(i*0.7);
+      iso.length(i*1.3);
+      iso(m1,m2,direct);
+      cache(iso,cached);
+      if(EPSILON < (direct-cached).abs().maxCoeff())
+      {
+         std::cout << "Incorrect cached SEiso covariance" << std::endl;
+         return EXIT_FAILURE;
+      }
+
+      sum.cov1().length(i*1.3);
+      sum(m1,m1,direct);
+      cache.inputs(m1);
+      cache(sum,cached);
+      cache.inputs(m1,m2);
+      if(EPSILON < (direct-cached).abs().maxCoeff())
+      {
+         std::cout << "Incorrect cached sum covariance" << std::endl;
+         return EXIT_FAILURE;
+      }
+   }
+
+   //***************************************************************************
+   // Repeat for inputs large enough to be evaluated in parallel.
+   //***************************************************************************
+   MatrixXd big1(MatrixXd::Random(3,150));
+   MatrixXd big2(MatrixXd::Random(3,140));
+   if(big1.cols()*big2.cols() < PARALLEL_MIN_SIZE)
+   {
+      std::cout << "Test inputs too small for parallel evaluation" << std::endl;
+      return EXIT_FAILURE;
+   }
+   cache.inputs(big1,big2);
+   sum(big1,big2,direct);
+   cache(sum,cached);
+   if(EPSILON < (direct-cached).abs().maxCoeff())
+   {
+      std::cout << "Incorrect cached covariance for large inputs" << std::endl;
+      return EXIT_FAILURE;
+   }
+   sum(big1,big1,direct);
+   cache.inputs(big1);
+   cache(sum,cached);
+   if(EPSILON < (direct-cached).abs().maxCoeff())
+   {
+      std::cout << "Incorrect cached covariance for large inputs" << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   return EXIT_SUCCESS;
+
+} // function testSqDistCache
+
+/**
+ * Stream buffer that reads from a string, but cannot seek, like a pipe.
+ */
+class ForwardOnlyBuf : public std::streambuf
+{
+private:
+
+   /**
+    * The contents of the stream.
+    */
+   std::string bytes_i;
+
+public:
+
+   /**
+    * Constructs a buffer for reading a copy of \c bytes.
+    */
+   explicit ForwardOnlyBuf(const std::string& bytes) : bytes_i(bytes)
+   {
+      char* begin = &bytes_i[0];
+      setg(begin,begin,begin+bytes_i.size());
+   }
+
+}; // class ForwardOnlyBuf
+
+/**
+ * Returns true if both bayes::gp::load and bayes::gp::MappedGP reject the
+ * given file contents with std::runtime_error.
+ */
+template<class Cov> bool rejectsFile(const std::string& bytes,
+                                     const std::string& filename)
+{
+   using namespace bayes::gp;
+   int rejected = 0;
+   try
+   {
+      std::istringstream in(bytes);
+      load<Cov>(in);
+   }
+   catch(std::runtime_error&)
+   {
+      ++rejected;
+   }
+
+   std::ofstream out(filename.c_str(),std::ios::binary|std::ios::trunc);
+   out.write(bytes.data(),bytes.size());
+   out.close();
+   try
+   {
+      MappedGP<Cov> mapped(filename);
+   }
+   catch(std::runtime_error&)
+   {
+      ++rejected;
+   }
+   std::remove(filename.c_str());
+
+   return 2==rejected;
+}
+
+/**
+ * Test that fitted Gaussian Processes can be saved and loaded, both by
+ * copying and by memory mapping, and give the same predictions.
+ */
+int testSerialize()
+{
+   using namespace Eigen;
+   using namespace bayes::gp;
+   typedef CovSum<CovSum<CovSEiso,CovSEiso>,CovNoise> Kernel;
+
+   //***************************************************************************
+   // Fit a Gaussian Process to random data.
+   //***************************************************************************
+   MatrixXd x(MatrixXd::Random(3,40));
+   VectorXd y(VectorXd::Random(40));
+   MatrixXd test(MatrixXd::Random(3,7));
+   CovSEiso iso(1.0,0.8);
+   iso.logScale(0.1); // exp then log does not give 0.1 exactly
+   FittedGP<Kernel> gp(iso+CovSEiso(0.3,4.0)+CovNoise(0.1));
+   gp.fit(x,y);
+   VectorXd expected;
+   gp.predict(test,expected);
+
+   //***************************************************************************
+   // Save it and load it back.
+   //***************************************************************************
+   const std::string filename("harness_gp.bin");
+   save(filename,gp);
+   FittedGP<Kernel> loaded = load<Kernel>(filename);
+   MappedGP<Kernel> moved(filename);
+   MappedGP<Kernel> mapped(std::move(moved)); // moves into a new object
+   moved = MappedGP<Kernel>(filename);        // assigns to an empty object
+   mapped = std::move(moved);                 // replaces an existing mapping
+
+   VectorXd loadedMean, mappedMean;
+   loaded.predict(test,loadedMean);
+   mapped.predict(test,mappedMean);
+   double error = std::max((expected-loadedMean).lpNorm<Infinity>(),
+                           (expected-mappedMean).lpNorm<Infinity>());
+   error = std::max(error,(gp.chol()-mapped.chol()).lpNorm<Infinity>());
+   if(EPSILON < error)
+   {
+      std::cout << "Loaded Gaussian Process differs from original"
+         << std::endl;
+      std::remove(filename.c_str());
+      return EXIT_FAILURE;
+   }
+
+   //***************************************************************************
+   // Hyperparameters must be restored exactly, not just approximately.
+   //***************************************************************************
+   const Kernel* covs[] = { &loaded.cov(), &mapped.cov() };
+   for(int i=0; i<2; ++i)
+   {
+      if( (gp.cov().cov1().cov1().logScale() !=
+           covs[i]->cov1().cov1().logScale()) ||
+          (gp.cov().cov1().cov1().length() != covs[i]->cov1().cov1().length()) ||
+          (gp.cov().cov1().cov2().logScale() !=
+           covs[i]->cov1().cov2().logScale()) ||
+          (gp.cov().cov1().cov2().length() != covs[i]->cov1().cov2().length()) ||
+          (gp.cov().cov2().var() != covs[i]->cov2().var()) )
+      {
+         std::cout << "Loaded hyperparameters differ from original"
+            << std::endl;
+         std::remove(filename.c_str());
+         return EXIT_FAILURE;
+      }
+   }
+
+   //***************************************************************************
+   // Check that loading with the wrong covariance type is rejected.
+   //***************************************************************************
+   bool rejected = false;
+   try
+   {
+      MappedGP<CovSum<CovSEiso,CovNoise> > wrong(filename);
+   }
+   catch(std::runtime_error&)
+   {
+      rejected = true;
+   }
+   std::remove(filename.c_str());
+   if(!rejected)
+   {
+      std::cout << "Loaded Gaussian Process with wrong covariance type"
+         << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   //***************************************************************************
+   // Check that truncated and corrupt files are rejected before any large
+   // allocation. The header stores the covariance size at byte 12, the
+   // number of input dimensions at byte 16, and the number of training
+   // points at byte 24.
+   //***************************************************************************
+   std::ostringstream out;
+   save(out,gp);
+   const std::string bytes = out.str();
+
+   const std::string truncated = bytes.substr(0,bytes.size()-sizeof(double));
+
+   std::string hugeN(bytes);
+   const std::uint64_t n = std::uint64_t(1)<<40;
+   std::memcpy(&hugeN[24],&n,sizeof(n));
+
+   std::string extraCov(bytes);
+   std::uint32_t covBytes;
+   std::memcpy(&covBytes,&extraCov[12],sizeof(covBytes));
+
+   std::string hugeDims(bytes.substr(0,GPFileHeader::SIZE+covBytes));
+   const std::uint64_t dims = ~std::uint64_t(0);
+   const std::uint64_t zero = 0;
+   std::memcpy(&hugeDims[16],&dims,sizeof(dims));
+   std::memcpy(&hugeDims[24],&zero,sizeof(zero));
+
+   extraCov.insert(GPFileHeader::SIZE+covBytes,sizeof(double),'\1');
+   covBytes += sizeof(double);
+   std::memcpy(&extraCov[12],&covBytes,sizeof(covBytes));
+
+   if(!rejectsFile<Kernel>(truncated,filename) ||
+      !rejectsFile<Kernel>(hugeN,filename) ||
+      !rejectsFile<Kernel>(hugeDims,filename) ||
+      !rejectsFile<Kernel>(extraCov,filename))
+   {
+      std::cout << "Loaded corrupt Gaussian Process file" << std::endl;
+      return EXIT_FAILURE;
+   }
+   if(rejectsFile<Kernel>(bytes,filename))
+   {
+      std::cout << "Rejected valid Gaussian Process file" << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   //***************************************************************************
+   // Streams that cannot seek are only checked when allocating, so sizes
+   // that cannot be allocated must still give std::runtime_error.
+   //***************************************************************************
+   ForwardOnlyBuf validBuf(bytes);
+   std::istream validStream(&validBuf);
+   VectorXd forwardMean;
+   load<Kernel>(validStream).predict(test,forwardMean);
+   if(EPSILON < (expected-forwardMean).lpNorm<Infinity>())
+   {
+      std::cout << "Incorrect Gaussian Process loaded from unseekable stream"
+         << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   std::string tooLarge(bytes);
+   const std::uint64_t largeN = std::uint64_t(1)<<29;
+   std::memcpy(&tooLarge[24],&largeN,sizeof(largeN));
+   ForwardOnlyBuf tooLargeBuf(tooLarge);
+   std::istream tooLargeStream(&tooLargeBuf);
+   try
+   {
+      load<Kernel>(tooLargeStream);
+      std::cout << "Loaded oversized Gaussian Process from unseekable stream"
+         << std::endl;
+      return EXIT_FAILURE;
+   }
+   catch(std::runtime_error&)
+   {
+   }
+
+   return EXIT_SUCCESS;
+
+} // function testSerialize
+
+/**
+ * Test that single point predictions match the generic prediction method,
+ * for fixed and dynamic numbers of dimensions.
+ */
+int testPointPredictor()
+{
+   using namespace Eigen;
+   using namespace bayes::gp;
+   typedef CovSum<CovSEiso,CovNoise> Kernel;
+
+   //***************************************************************************
+   // Fit a Gaussian Process to random data. The number of training points
+   // is deliberately not a multiple of the block size.
+   //***************************************************************************
+   MatrixXd x(MatrixXd::Random(4,150));
+   VectorXd y(VectorXd::Random(150));
+   MatrixXd test(MatrixXd::Random(4,10));
+   test.col(0) = x.col(3); // test point coinciding with training point
+   FittedGP<Kernel> gp(CovSEiso(1.2,0.7)+CovNoise(0.05));
+   gp.fit(x,y);
+   VectorXd expected;
+   gp.predict(test,expected);
+
+   //***************************************************************************
+   // Compare against point predictions.
+   //***************************************************************************
+   PointPredictor<Kernel,4> fixed(gp);
+   PointPredictor<Kernel> dynamic(gp);
+   for(int i=0; i<test.cols(); ++i)
+   {
+      const double error = std::max(std::abs(expected(i)-fixed(test.col(i))),
+                                 std::abs(expected(i)-dynamic(test.col(i))));
+      if(EPSILON < error)
+      {
+         std::cout << "Incorrect point prediction" << std::endl;
+         return EXIT_FAILURE;
+      }
+   }
+
+   return EXIT_SUCCESS;
+
+} // function testPointPredictor
+
+/**
+ * Test Kronecker products and solves, using inputs on a three dimensional
+ * grid, and compare against the full covariance matrix.
+ */
+int testKronSolver()
+{
+   using namespace Eigen;
+   using namespace bayes::gp;
+
+   //***************************************************************************
+   // Create grid coordinates, and the full set of grid points. The last
+   // dimension varies fastest, to match the Kronecker product ordering.
+   //***************************************************************************
+   std::vector<VectorXd> coords;
+   coords.push_back(VectorXd::LinSpaced(3,0,1));
+   coords.push_back(VectorXd::LinSpaced(4,-1,2));
+   coords.push_back(VectorXd::LinSpaced(2,0.5,1.5));
+   MatrixXd grid(3,3*4*2);
+   int col = 0;
+   for(int i=0; i<3; ++i)
+      for(int j=0; j<4; ++j)
+         for(int k=0; k<2; ++k)
+            grid.col(col++) << coords[0](i), coords[1](j), coords[2](k);
+
+   //***************************************************************************
+   // Create Kronecker factors for the Squared Exponential covariance, which
+   // is a product over dimensions.
+   //***************************************************************************
+   const double scale = 1.7, length = 0.9, noise = 0.2;
+   std::vector<MatrixXd> factors(coords.size());
+   for(std::size_t d=0; d<coords.size(); ++d)
+   {
+      ArrayXXd k;
+      CovSEiso(d==0 ? scale : 1.0, length)(coords[d].transpose(),k);
+      factors[d] = k.matrix();
+   }
+   ArrayXXd fullArray;
+   CovSEiso(scale,length)(grid,fullArray);
+   MatrixXd full = fullArray.matrix();
+
+   //***************************************************************************
+   // Check multiplication, solve and log determinant.
+   //***************************************************************************
+   VectorXd y(VectorXd::Random(grid.cols()));
+   double error = (kronMultiply(factors,y)-full*y).lpNorm<Infinity>();
+
+   full += noise*MatrixXd::Identity(full.rows(),full.cols());
+   KronSolver solver(factors,noise);
+   LLT<MatrixXd> llt(full);
+   error = std::max(error,(solver.solve(y)-llt.solve(y)).lpNorm<Infinity>());
+   const double logDet = 2*llt.matrixLLT().diagonal().array().log().sum();
+   error = std::max(error,std::abs(solver.logDeterminant()-logDet));
+
+   if(EPSILON < error)
+   {
+      std::cout << "Incorrect Kronecker solve" << std::endl;
+      return EXIT_FAILURE;
+   }
+   return EXIT_SUCCESS;
+
+} // function testKronSolver
+
+/**
+ * Test that coregionalised Gaussian Process predictions match those
+ * calculated using the full covariance matrix.
+ */
+int testCoregGP()
+{
+   using namespace Eigen;
+   using namespace bayes::gp;
+   typedef CovSum<CovSEiso,CovSEiso> Kernel;
+   const int OUTPUTS = 3;
+   const double NOISE = 0.1;
+
+   //***************************************************************************
+   // Create random data and coregionalisation matrix.
+   //***************************************************************************
+   MatrixXd x(MatrixXd::Random(2,25));
+   MatrixXd y(MatrixXd::Random(25,OUTPUTS));
+   MatrixXd test(MatrixXd::Random(2,6));
+   MatrixXd w(MatrixXd::Random(OUTPUTS,2));
+   MatrixXd coreg = w*w.transpose() + 0.5*MatrixXd::Identity(OUTPUTS,OUTPUTS);
+   CovCoreg<Kernel> cov(CovSEiso(1.1,0.6)+CovSEiso(0.4,3.0),coreg);
+
+   //***************************************************************************
+   // Fit and predict using the Kronecker structure.
+   //***************************************************************************
+   CoregGP<Kernel> gp(cov,NOISE);
+   gp.fit(x,y);
+   MatrixXd mean;
+   gp.predict(test,mean);
+
+   //***************************************************************************
+   // Fit and predict using the full covariance.
+   //***************************************************************************
+   ArrayXXd full, cross;
+   cov(x,full);
+   cov(test,x,cross);
+   MatrixXd fullCov = full.matrix()+NOISE*MatrixXd::Identity(full.rows(),
+                                                             full.cols());
+   LLT<MatrixXd> llt(fullCov);
+   VectorXd yVec = Map<VectorXd>(y.data(),y.size());
+   VectorXd alpha = llt.solve(yVec);
+   VectorXd expected = cross.matrix()*alpha;
+   const double logLik = -0.5*( yVec.dot(alpha)
+      + 2*llt.matrixLLT().diagonal().array().log().sum()
+      + yVec.size()*std::log(2*M_PI) );
+
+   double error = (Map<VectorXd>(mean.data(),mean.size())-expected)
+      .lpNorm<Infinity>();
+   error = std::max(error,std::abs(logLik-gp.logLikelihood()));
+   if(EPSILON < error)
+   {
+      std::cout << "Incorrect coregionalised prediction" << std::endl;
+      return EXIT_FAILURE;
+   }
+   return EXIT_SUCCESS;
+
+} // function testCoregGP
+
+/**
+ * Test that operator+ for covariance functions only applies to covariance
+ * functions, and does not hide operator+ for other types.
+ */
+int testCovSumOperator()
+{
+   using namespace Eigen;
+   using namespace bayes::gp;
+
+   //***************************************************************************
+   // Only covariance functions with n by n results can be summed.
+   //***************************************************************************
+   static_assert(isCovariance<CovSEiso>::value &&
+                 isCovariance<CovNoise>::value &&
+                 isCovariance< CovSum<CovSEiso,CovNoise> >::value,
+                 "Covariance function not recognised");
+   static_assert(!isCovariance< CovCoreg<CovSEiso> >::value,
+                 "Coregionalised covariance can be summed");
+   static_assert(!isCovariance<MatrixXd>::value &&
+                 !isCovariance<std::string>::value,
+                 "Non-covariance type recognised as covariance");
+
+   //***************************************************************************
+   // Other types still use their own operator+.
+   //***************************************************************************
+   MatrixXd a(MatrixXd::Random(3,4));
+   MatrixXd b(MatrixXd::Random(3,4));
+   MatrixXd c = a + b;
+   if(EPSILON < (c.array()-a.array()-b.array()).abs().maxCoeff())
+   {
+      std::cout << "Incorrect matrix sum" << std::endl;
+      return EXIT_FAILURE;
+   }
+   if(std::string("CovSEiso+CovNoise") !=
+      std::string("CovSEiso") + std::string("+CovNoise"))
+   {
+      std::cout << "Incorrect string concatenation" << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   return EXIT_SUCCESS;
+
+} // function testCovSumOperator
+
+/**
+ * Numeric punctuation using ',' as the decimal point, as in many locales.
+ */
+class CommaDecimal : public std::numpunct<char>
+{
+protected:
+
+   /**
+    * Returns the decimal point.
+    */
+   char do_decimal_point() const { return ','; }
+
+}; // class CommaDecimal
+
+/**
+ * Test that covariance functions parsed from text give the same results
+ * as the equivalent compile time types.
+ */
+int testCovParser()
+{
+   using namespace Eigen;
+   using namespace bayes::gp;
+
+   //***************************************************************************
+   // Create equivalent covariance functions.
+   //***************************************************************************
+   auto templated = CovSEiso(2.0,0.5)+CovNoise(0.1)+CovSEiso(0.3,4.0);
+   CovHandle parsed = parseCov(" CovSEiso(2.0, 0.5) + (CovNoise(1e-1)"
+                               "+CovSEiso(0.3,4))");
+   CovHandle copy(parsed);
+   copy = parseCov("CovSEiso()");
+   static_assert(std::is_nothrow_move_constructible<CovHandle>::value &&
+                 std::is_nothrow_move_assignable<CovHandle>::value,
+                 "CovHandle copies instead of moving");
+
+   //***************************************************************************
+   // Compare direct and cached evaluation.
+   //***************************************************************************
+   MatrixXd m1(MatrixXd::Random(3,12));
+   MatrixXd m2(MatrixXd::Random(3,9));
+   m2.col(0) = m1.col(0);
+   ArrayXXd expected, actual;
+   MatrixXd actualMatrix;
+   templated(m1,m2,expected);
+   parsed(m1,m2,actual);
+   double error = (expected-actual).abs().maxCoeff();
+   parsed(m1,m2,actualMatrix);
+   error = std::max(error,(expected-actualMatrix.array()).abs().maxCoeff());
+   SqDistCache cache(m1,m2);
+   cache(parsed,actual);
+   error = std::max(error,(expected-actual).abs().maxCoeff());
+   CovSEiso().fromSqDist(cache.sqDist(),expected);
+   CovHandle moved(std::move(copy));
+   moved(m1,m2,actual);
+   error = std::max(error,(expected-actual).abs().maxCoeff());
+   if(EPSILON < error)
+   {
+      std::cout << "Incorrect parsed covariance" << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   //***************************************************************************
+   // Check that parsing does not depend on the global locale.
+   //***************************************************************************
+   const std::locale original = std::locale::global(
+      std::locale(std::locale::classic(),new CommaDecimal));
+   std::setlocale(LC_ALL,"de_DE.UTF-8"); // ignored if not installed
+   try
+   {
+      parseCov("CovSEiso(2.0,0.5)+CovNoise(0.1)")(m1,m2,actual);
+   }
+   catch(std::invalid_argument&)
+   {
+      std::locale::global(original);
+      std::setlocale(LC_ALL,"C");
+      std::cout << "Parsing depends on locale" << std::endl;
+      return EXIT_FAILURE;
+   }
+   std::locale::global(original);
+   std::setlocale(LC_ALL,"C");
+   (CovSEiso(2.0,0.5)+CovNoise(0.1))(m1,m2,expected);
+   if(EPSILON < (expected-actual).abs().maxCoeff())
+   {
+      std::cout << "Incorrect covariance parsed with comma locale"
+         << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   //***************************************************************************
+   // Check that invalid expressions are rejected.
+   //***************************************************************************
+   const char* invalid[] = { "", "CovSEiso", "CovSEiso(1,2,3)", "CovFoo()",
+                             "CovNoise(1)+", "(CovNoise(1)", "CovNoise(x)",
+                             "CovNoise(1) CovNoise(2)",
+                             "CovSEiso(-1,0)+CovNoise(-3)", "CovSEiso(0)",
+                             "CovSEiso(1,-2)", "CovSEiso(nan,1)",
+                             "CovSEiso(1,inf)", "CovNoise(-3)",
+                             "CovNoise(nan)", "CovNoise(inf)",
+                             "CovNoise(0x10)", "CovNoise(1e)", "CovNoise(.)",
+                             "CovNoise(1,5)" };
+   for(std::size_t i=0; i<sizeof(invalid)/sizeof(invalid[0]); ++i)
+   {
+      try
+      {
+         parseCov(invalid[i]);
+         std::cout << "Accepted invalid expression: " << invalid[i]
+            << std::endl;
+         return EXIT_FAILURE;
+      }
+      catch(std::invalid_argument&)
+      {
+      }
+   }
+
+   return EXIT_SUCCESS;
+
+} // function testCovParser
+
 /**
  * Test that the squared distance is working.
  */
@@ -213,6 +873,76 @@ int main()
          return EXIT_FAILURE;
       }
       std::cout << "Noise test passed." << std::endl;
+
+      //************************************************************************
+      // Test squared distance cache.
+      //************************************************************************
+      if(EXIT_SUCCESS!=testSqDistCache())
+      {
+         std::cout << "Squared distance cache test failed." << std::endl;
+         return EXIT_FAILURE;
+      }
+      std::cout << "Squared distance cache test passed." << std::endl;
+
+      //************************************************************************
+      // Test saving and loading fitted Gaussian Processes.
+      //************************************************************************
+      if(EXIT_SUCCESS!=testSerialize())
+      {
+         std::cout << "Serialisation test failed." << std::endl;
+         return EXIT_FAILURE;
+      }
+      std::cout << "Serialisation test passed." << std::endl;
+
+      //************************************************************************
+      // Test single point prediction.
+      //************************************************************************
+      if(EXIT_SUCCESS!=testPointPredictor())
+      {
+         std::cout << "Point predictor test failed." << std::endl;
+         return EXIT_FAILURE;
+      }
+      std::cout << "Point predictor test passed." << std::endl;
+
+      //************************************************************************
+      // Test Kronecker structured solves.
+      //************************************************************************
+      if(EXIT_SUCCESS!=testKronSolver())
+      {
+         std::cout << "Kronecker solver test failed." << std::endl;
+         return EXIT_FAILURE;
+      }
+      std::cout << "Kronecker solver test passed." << std::endl;
+
+      //************************************************************************
+      // Test coregionalised Gaussian Process.
+      //************************************************************************
+      if(EXIT_SUCCESS!=testCoregGP())
+      {
+         std::cout << "Coregionalised GP test failed." << std::endl;
+         return EXIT_FAILURE;
+      }
+      std::cout << "Coregionalised GP test passed." << std::endl;
+
+      //************************************************************************
+      // Test that covariance sums do not affect other types.
+      //************************************************************************
+      if(EXIT_SUCCESS!=testCovSumOperator())
+      {
+         std::cout << "Covariance sum operator test failed." << std::endl;
+         return EXIT_FAILURE;
+      }
+      std::cout << "Covariance sum operator test passed." << std::endl;
+
+      //************************************************************************
+      // Test runtime covariance functions.
+      //************************************************************************
+      if(EXIT_SUCCESS!=testCovParser())
+      {
+         std::cout << "Covariance parser test failed." << std::endl;
+         return EXIT_FAILURE;
+      }
+      std::cout << "Covariance parser test passed." << std::endl;
       
    }
    catch(std::exception& e)